@@ -0,0 +1,60 @@
+#include "dotenv.h"
+#include "dotenv.hpp"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <format>
+#include <string>
+#include <vector>
+
+// Benchmark: 200 chaves KAFKA_ entre 20k. Arg 0 percorre o store inteiro com
+// dotenv_enumerate e filtra com strncmp; Arg 1 usa dotenv_enumerate_prefix,
+// que faz busca binária no índice ordenado de cada shard
+namespace {
+
+constexpr int prefix_group_size = 200;
+constexpr int prefix_store_size = 20000;
+
+struct prefix_count {
+    size_t matches = 0;
+};
+
+auto count_kafka(const char *key, const char * /*value*/, void *user_data)
+    -> int {
+    if (std::strncmp(key, "KAFKA_", 6) == 0) {
+        ++static_cast<prefix_count *>(user_data)->matches;
+    }
+    return 0;
+}
+
+} // namespace
+
+static void BM_PrefixEnumeration(benchmark::State &state) {
+    const bool indexed = state.range(0) == 1;
+    std::vector<std::string> keys;
+    keys.reserve(prefix_store_size);
+    for (int i = 0; i < prefix_store_size; ++i) {
+        keys.push_back((i % (prefix_store_size / prefix_group_size) == 0)
+                           ? std::format("KAFKA_SETTING_{}", i)
+                           : std::format("SERVICE_SETTING_{}", i));
+        dotenv::set(keys.back(), "value");
+    }
+
+    for (auto _ : state) {
+        prefix_count counted;
+        if (indexed) {
+            dotenv_enumerate_prefix("KAFKA_", count_kafka, &counted);
+        } else {
+            dotenv_enumerate(count_kafka, &counted);
+        }
+        benchmark::DoNotOptimize(counted.matches);
+    }
+
+    for (const auto &key : keys) {
+        dotenv::unset(key);
+    }
+    state.SetItemsProcessed(state.iterations() * prefix_group_size);
+}
+BENCHMARK(BM_PrefixEnumeration)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
@@ -1,5 +1,7 @@
 #include "dotenv.hpp"
+#include <array>
 #include <benchmark/benchmark.h>
+#include <chrono>
 #include <filesystem>
 #include <format>
 #include <fstream>
@@ -88,31 +90,32 @@ BENCHMARK_DEFINE_F(FileBenchmarkFixture, LoadLargeFile)
 BENCHMARK_REGISTER_F(FileBenchmarkFixture, LoadLargeFile)
     ->Unit(benchmark::kMicrosecond);
 
-// Benchmark: dotenv::save() - TEMPORARIAMENTE DESABILITADO
-// FIXME: Segmentation fault durante benchmark - investigar dotenv::save()
-/*
-BENCHMARK_F(FileBenchmarkFixture, SaveOperation)(benchmark::State &state) {
-    // Setup: criar algumas variáveis para salvar
-    for (int i = 0; i < state.range(0); ++i) {
+// Benchmark: save_to_file() de state.range(0) entradas (snapshot, um buffer,
+// um write, fsync e rename)
+BENCHMARK_DEFINE_F(FileBenchmarkFixture, SaveOperation)
+(benchmark::State &state) {
+    const auto count = static_cast<int>(state.range(0));
+    for (int i = 0; i < count; ++i) {
         dotenv::set("SAVE_VAR_" + std::to_string(i),
                     "save_value_" + std::to_string(i));
     }
 
     for (auto _ : state) {
-        dotenv::save("benchmark_output.env");
+        dotenv::save_to_file("benchmark_output.env");
     }
 
     // Cleanup
     std::filesystem::remove("benchmark_output.env");
-    for (int i = 0; i < state.range(0); ++i) {
+    for (int i = 0; i < count; ++i) {
         dotenv::unset("SAVE_VAR_" + std::to_string(i));
     }
 
-    state.SetItemsProcessed(state.iterations());
+    state.SetItemsProcessed(state.iterations() * count);
 }
 BENCHMARK_REGISTER_F(FileBenchmarkFixture, SaveOperation)
-    ->Unit(benchmark::kMicrosecond);
-*/
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
 
 // Benchmark: load + get sequence (simulando uso real)
 BENCHMARK_DEFINE_F(FileBenchmarkFixture, LoadThenGet)(benchmark::State &state) {
@@ -161,3 +164,286 @@ static void BM_ParsingQuotedValues(benchmark::State &state) {
     state.SetItemsProcessed(state.iterations());
 }
 BENCHMARK(BM_ParsingQuotedValues);
+
+// Benchmark: bundle de 50k chaves interpoladas, das quais só 300 são lidas.
+// Arg(0) = interpolation::eager, Arg(1) = interpolation::lazy
+static void BM_InterpolatedBundle(benchmark::State &state) {
+    const std::string filename = "interpolated_bundle.env";
+    constexpr int num_vars = 50000;
+    {
+        std::ofstream file(filename);
+        file << "BASE_HOST=cluster.internal\n";
+        for (int i = 0; i < 100; ++i) {
+            file << "PORT_" << i << "=" << 9000 + i << "\n";
+        }
+        for (int i = 0; i < num_vars; ++i) {
+            file << "SERVICE_" << i << "_URL=https://${BASE_HOST}:${PORT_"
+                 << i % 100 << "}/svc/" << i << "/${SERVICE_"
+                 << (i + 1) % num_vars << "_NAME:-default}\n";
+        }
+    }
+
+    const auto expansion = (state.range(0) == 0)
+                               ? dotenv::interpolation::eager
+                               : dotenv::interpolation::lazy;
+    for (auto _ : state) {
+        auto result = dotenv::load_legacy(
+            filename, {.apply_to_process = dotenv::process_env_apply::no,
+                       .expansion = expansion});
+        benchmark::DoNotOptimize(result);
+
+        // Só uma fração das chaves é lida pelo processo
+        for (int i = 0; i < num_vars; i += num_vars / 300) {
+            auto value = dotenv::value(std::format("SERVICE_{}_URL", i));
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_vars);
+
+    std::filesystem::remove(filename);
+}
+BENCHMARK(BM_InterpolatedBundle)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+// Benchmark: configuração em três camadas (.env, .env.production, .env.local)
+// Arg(0) = três chamadas a load(), Arg(1) = load_layers(),
+// Arg(2) = load_layers() com parallel_parse
+static void BM_LayeredLoad(benchmark::State &state) {
+    const std::vector<std::string> layers = {
+        "layer_base.env", "layer_production.env", "layer_local.env"};
+    constexpr std::array<int, 3> layer_sizes{5000, 1000, 100};
+    for (size_t layer = 0; layer < layers.size(); ++layer) {
+        std::ofstream file(layers[layer]);
+        for (int i = 0; i < layer_sizes[layer]; ++i) {
+            file << "LAYERED_VAR_" << i << "=layer_" << layer << "_value_"
+                 << i << "_abcdefghijklmnopqrstuvwxyz\n";
+        }
+    }
+
+    const dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::yes,
+        .parallel_parse = (state.range(0) == 2)};
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            for (const auto &layer : layers) {
+                auto result = dotenv::load_legacy(layer, options);
+                benchmark::DoNotOptimize(result);
+            }
+        } else {
+            auto result = dotenv::load_layers(layers, options);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 6100);
+
+    for (const auto &layer : layers) {
+        std::filesystem::remove(layer);
+    }
+}
+BENCHMARK(BM_LayeredLoad)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Unit(benchmark::kMillisecond);
+
+// Benchmark: diretório com um arquivo por variável, como um Secret do
+// Kubernetes montado como volume (300 secrets)
+static void BM_LoadDirectory(benchmark::State &state) {
+    const std::filesystem::path directory = "secrets_bench";
+    constexpr int num_secrets = 300;
+    std::filesystem::create_directories(directory);
+    for (int i = 0; i < num_secrets; ++i) {
+        std::ofstream file(directory / std::format("SECRET_{}", i));
+        file << "secret_value_" << i << "_abcdefghijklmnopqrstuvwxyz\n";
+    }
+
+    for (auto _ : state) {
+        auto result = dotenv::load_directory(
+            directory.string(),
+            {.apply_to_process = dotenv::process_env_apply::no,
+             .strip_trailing_newline = true});
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * num_secrets);
+
+    std::filesystem::remove_all(directory);
+}
+BENCHMARK(BM_LoadDirectory)->Unit(benchmark::kMicrosecond);
+
+// Benchmark: arquivo com 5k linhas inválidas entre 5k definições.
+// Arg(0) = sem sink, Arg(1) = diagnósticos contados em um sink
+static void BM_LoadRejectedLines(benchmark::State &state) {
+    const std::string filename = "rejected_lines.env";
+    constexpr int num_lines = 5000;
+    {
+        std::ofstream file(filename);
+        for (int i = 0; i < num_lines; ++i) {
+            file << "REJECT_VAR_" << i << "=value_" << i << '\n';
+            file << "not a definition " << i << '\n';
+        }
+    }
+
+    size_t diagnostics = 0;
+    dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no};
+    if (state.range(0) == 1) {
+        options.on_diagnostic = [&diagnostics](const dotenv::diagnostic &) {
+            ++diagnostics;
+        };
+    }
+
+    for (auto _ : state) {
+        auto result = dotenv::load_legacy(filename, options);
+        benchmark::DoNotOptimize(result);
+    }
+    benchmark::DoNotOptimize(diagnostics);
+    state.SetItemsProcessed(state.iterations() * num_lines * 2);
+
+    std::filesystem::remove(filename);
+}
+BENCHMARK(BM_LoadRejectedLines)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+// Benchmark: 20k definições com os limites padrão (laço especializado com
+// limites constantes) ou configurados em tempo de execução.
+// Arg(0) = parse_limits{}, Arg(1) = max_value_length = 16384
+static void BM_ParseLimits(benchmark::State &state) {
+    const std::string filename = "parse_limits.env";
+    constexpr int num_vars = 20000;
+    {
+        std::ofstream file(filename);
+        for (int i = 0; i < num_vars; ++i) {
+            file << "LIMIT_VAR_" << i << "=value_" << i
+                 << "_abcdefghijklmnopqrstuvwxyz\n";
+        }
+    }
+
+    dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no};
+    if (state.range(0) == 1) {
+        options.limits.max_value_length = 16384;
+    }
+
+    for (auto _ : state) {
+        auto result = dotenv::load_legacy(filename, options);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * num_vars);
+
+    std::filesystem::remove(filename);
+}
+BENCHMARK(BM_ParseLimits)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Benchmark: 20k definições sem orçamento (commit em streaming) ou com um
+// orçamento folgado (carga em etapas, contadores atômicos no parser).
+// Arg(0) = load_budget{}, Arg(1) = max_lines/max_memory/max_duration
+static void BM_LoadWithBudget(benchmark::State &state) {
+    const std::string filename = "load_budget.env";
+    constexpr int num_vars = 20000;
+    {
+        std::ofstream file(filename);
+        for (int i = 0; i < num_vars; ++i) {
+            file << "BUDGET_VAR_" << i << "=value_" << i
+                 << "_abcdefghijklmnopqrstuvwxyz\n";
+        }
+    }
+
+    dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no};
+    if (state.range(0) == 1) {
+        options.budget = {.max_memory = 64U * 1024U * 1024U,
+                          .max_lines = 1000000,
+                          .max_duration = std::chrono::seconds(10)};
+    }
+
+    for (auto _ : state) {
+        auto result = dotenv::load_legacy(filename, options);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * num_vars);
+
+    std::filesystem::remove(filename);
+}
+BENCHMARK(BM_LoadWithBudget)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Benchmark: 20k definições por inquilino. Arg(0) = load() no ambiente
+// padrão, Arg(1) = dotenv::environment novo a cada iteração (criação,
+// carga e destruição do store isolado)
+static void BM_EnvironmentLoad(benchmark::State &state) {
+    const std::string filename = "environment_bench.env";
+    constexpr int num_vars = 20000;
+    {
+        std::ofstream file(filename);
+        for (int i = 0; i < num_vars; ++i) {
+            file << "TENANT_VAR_" << i << "=value_" << i
+                 << "_abcdefghijklmnopqrstuvwxyz\n";
+        }
+    }
+
+    const dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no};
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            auto result = dotenv::load_legacy(filename, options);
+            benchmark::DoNotOptimize(result);
+        } else {
+            dotenv::environment tenant;
+            auto result = tenant.load(filename, options);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_vars);
+
+    std::filesystem::remove(filename);
+}
+BENCHMARK(BM_EnvironmentLoad)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Benchmark: inicialização a partir de 50k variáveis com 100 consultas.
+// Arg(0) = load() do .env, Arg(1) = load_compiled() da imagem pré-compilada
+static void BM_StartupCompiled(benchmark::State &state) {
+    const std::string source = "startup_bench.env";
+    const std::string image = "startup_bench.envc";
+    constexpr int num_vars = 50000;
+    {
+        std::ofstream file(source);
+        for (int i = 0; i < num_vars; ++i) {
+            file << "STARTUP_VAR_" << i << "=value_" << i
+                 << "_abcdefghijklmnopqrstuvwxyz0123456789\n";
+        }
+    }
+    if (dotenv::compile(source, image) != dotenv::dotenv_error::success) {
+        state.SkipWithError("compile failed");
+        return;
+    }
+
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            auto result = dotenv::load_legacy(
+                source, {.apply_to_process = dotenv::process_env_apply::no});
+            benchmark::DoNotOptimize(result);
+            for (int i = 0; i < num_vars; i += num_vars / 100) {
+                auto value = dotenv::get(std::format("STARTUP_VAR_{}", i));
+                benchmark::DoNotOptimize(value);
+            }
+        } else {
+            auto [error, env] = dotenv::load_compiled(image);
+            benchmark::DoNotOptimize(error);
+            for (int i = 0; i < num_vars; i += num_vars / 100) {
+                auto value = env.get(std::format("STARTUP_VAR_{}", i));
+                benchmark::DoNotOptimize(value);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_vars);
+
+    std::filesystem::remove(source);
+    std::filesystem::remove(image);
+}
+BENCHMARK(BM_StartupCompiled)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
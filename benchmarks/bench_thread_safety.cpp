@@ -1,8 +1,11 @@
+#include "dotenv.h"
 #include "dotenv.hpp"
 #include <atomic>
 #include <benchmark/benchmark.h>
 #include <chrono>
+#include <cstring>
 #include <format>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -217,3 +220,183 @@ BENCHMARK_DEFINE_F(ThreadSafetyBenchmark, ContentionTest)
 BENCHMARK_REGISTER_F(ThreadSafetyBenchmark, ContentionTest)
     ->Range(1, 8) // 1 to 8 threads
     ->Unit(benchmark::kMicrosecond);
+
+// Benchmark: carga dominada por leituras (99 leituras : 1 escrita), onde os
+// locks leitor-escritor dos shards permitem leituras em paralelo
+BENCHMARK_DEFINE_F(ThreadSafetyBenchmark, ReadMostly)
+(benchmark::State &state) {
+    const auto num_threads = static_cast<int>(state.range(0));
+    constexpr int ops_per_thread = 1000;
+    constexpr int write_every = 100; // 99:1
+
+    // Chaves pré-formatadas para não medir std::format
+    std::vector<std::string> keys;
+    keys.reserve(100);
+    for (int i = 0; i < 100; ++i) {
+        keys.emplace_back(std::format("THREAD_VAR_{}", i));
+    }
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&keys, t]() {
+                for (int i = 0; i < ops_per_thread; ++i) {
+                    const auto &key = keys[static_cast<size_t>((i + t) % 100)];
+                    if (i % write_every == 0) {
+                        dotenv::set(key, "updated_value");
+                    } else {
+                        auto result = dotenv::get(key);
+                        benchmark::DoNotOptimize(result);
+                    }
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_threads * ops_per_thread);
+}
+BENCHMARK_REGISTER_F(ThreadSafetyBenchmark, ReadMostly)
+    ->RangeMultiplier(2)
+    ->Range(1, 64) // 1 to 64 threads
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Benchmark: cada thread escreve repetidamente a sua própria chave. As chaves
+// caem em shards diferentes, então a vazão deve crescer com o número de
+// threads enquanto nenhuma escrita tocar estado comum a todos os shards
+BENCHMARK_DEFINE_F(ThreadSafetyBenchmark, ConcurrentWritersAcrossShards)
+(benchmark::State &state) {
+    const auto num_threads = static_cast<int>(state.range(0));
+    constexpr int writes_per_thread = 20000;
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([t]() {
+                const auto key = std::format("SHARD_WRITER_{}", t);
+                for (int i = 0; i < writes_per_thread; ++i) {
+                    dotenv::set(key, "value");
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    for (int t = 0; t < num_threads; ++t) {
+        dotenv::unset(std::format("SHARD_WRITER_{}", t));
+    }
+    state.SetItemsProcessed(state.iterations() * num_threads *
+                            writes_per_thread);
+}
+BENCHMARK_REGISTER_F(ThreadSafetyBenchmark, ConcurrentWritersAcrossShards)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Benchmark: leitura de um grupo de 3 chaves relacionadas com escritas
+// concorrentes. Arg 0 usa dotenv::snapshot (trava todos os shards para fixar
+// o estado), Arg 1 usa dotenv::read_consistent (fixa só os shards lidos e
+// valida a geração)
+BENCHMARK_DEFINE_F(ThreadSafetyBenchmark, ConsistentGroupRead)
+(benchmark::State &state) {
+    const bool optimistic = state.range(0) == 1;
+    dotenv::set("GROUP_HOST", "db.internal");
+    dotenv::set("GROUP_PORT", "5432");
+    dotenv::set("GROUP_USER", "service");
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&stop]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            dotenv::set("THREAD_VAR_0", "updated_value");
+            std::this_thread::yield();
+        }
+    });
+
+    for (auto _ : state) {
+        if (optimistic) {
+            dotenv::read_consistent([](const dotenv::view &env) {
+                auto host = env.get("GROUP_HOST");
+                auto port = env.get("GROUP_PORT");
+                auto user = env.get("GROUP_USER");
+                benchmark::DoNotOptimize(host.size() + port.size() +
+                                         user.size());
+            });
+        } else {
+            dotenv::snapshot pinned;
+            auto host = pinned.get("GROUP_HOST");
+            auto port = pinned.get("GROUP_PORT");
+            auto user = pinned.get("GROUP_USER");
+            benchmark::DoNotOptimize(host.size() + port.size() + user.size());
+        }
+    }
+
+    stop = true;
+    writer.join();
+    for (const char *key : {"GROUP_HOST", "GROUP_PORT", "GROUP_USER"}) {
+        dotenv::unset(key);
+    }
+}
+BENCHMARK_REGISTER_F(ThreadSafetyBenchmark, ConsistentGroupRead)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kNanosecond);
+
+// Benchmark: enumeração completa de 20k chaves com um escritor concorrente.
+// Arg 0 usa dotenv_enumerate (callback C), Arg 1 o range dotenv::entries();
+// nenhum dos dois segura locks do store durante a iteração
+static auto count_entry(const char *key, const char *value, void *user_data)
+    -> int {
+    *static_cast<size_t *>(user_data) += std::strlen(key) + std::strlen(value);
+    return 0;
+}
+
+BENCHMARK_DEFINE_F(ThreadSafetyBenchmark, EnumerateUnderWrites)
+(benchmark::State &state) {
+    const bool range = state.range(0) == 1;
+    constexpr int key_count = 20000;
+    for (int i = 0; i < key_count; ++i) {
+        dotenv::set(std::format("ENUM_VAR_{}", i),
+                    std::format("enum_value_{}", i));
+    }
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&stop]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            dotenv::set("THREAD_VAR_0", "updated_value");
+            std::this_thread::yield();
+        }
+    });
+
+    for (auto _ : state) {
+        size_t bytes = 0;
+        if (range) {
+            for (auto [key, value] : dotenv::entries()) {
+                bytes += key.size() + value.size();
+            }
+        } else {
+            dotenv_enumerate(count_entry, &bytes);
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+
+    stop = true;
+    writer.join();
+    for (int i = 0; i < key_count; ++i) {
+        dotenv::unset(std::format("ENUM_VAR_{}", i));
+    }
+    state.SetItemsProcessed(state.iterations() * key_count);
+}
+BENCHMARK_REGISTER_F(ThreadSafetyBenchmark, EnumerateUnderWrites)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
@@ -8,14 +8,15 @@ extern "C" {
 #include "dotenv_errors.h" /* Shared error codes */
 #include <stdbool.h>       /* for bool (C99+) */
 #include <stddef.h>        /* for size_t */
+#include <stdint.h>        /* for uint64_t */
 
 /* Load options structure for advanced configuration */
 typedef struct {
     int replace_existing;   /* 0=preserve existing, 1=replace existing */
     int apply_to_system;    /* 0=internal only, 1=apply to system environment */
-    size_t max_line_length; /* Maximum allowed line length (0=use default) */
-    size_t max_key_length;  /* Maximum allowed key length (0=use default) */
-    size_t max_value_length; /* Maximum allowed value length (0=use default) */
+    size_t max_line_length; /* Longer lines are skipped (0=default, 8192) */
+    size_t max_key_length;  /* Longer keys are rejected (0=default, 256) */
+    size_t max_value_length; /* Longer values are truncated (0=default, 4096) */
 } dotenv_load_options_t;
 
 /* Statistics structure for load operations */
@@ -28,6 +29,24 @@ typedef struct {
     int lines_processed;    /* Total number of lines processed */
 } dotenv_load_stats_t;
 
+/* Layout version of dotenv_load_report_t; fields are only ever appended */
+#define DOTENV_LOAD_REPORT_VERSION 1
+
+/* Detailed report of one load: counters plus phase timings */
+typedef struct {
+    unsigned struct_size; /* Set by the caller to sizeof(dotenv_load_report_t);
+                             the library writes back how much it filled */
+    unsigned version;     /* DOTENV_LOAD_REPORT_VERSION of the library */
+    dotenv_load_stats_t stats; /* Same counters as dotenv_load_ex */
+    int lines_too_long;        /* Lines skipped for exceeding the limit */
+    int values_truncated;      /* Values cut at the value length limit */
+    uint64_t open_ns;          /* Opening and mapping the file */
+    uint64_t parse_ns;   /* Tokenizing, newline scanning and interpolation */
+    uint64_t commit_ns;  /* Writing the batch into the internal store */
+    uint64_t apply_ns;   /* Copying into the system environment (0 if off) */
+    uint64_t total_ns;   /* Whole load */
+} dotenv_load_report_t;
+
 /* ==== Core Loading Functions ==== */
 
 /**
@@ -40,6 +59,20 @@ typedef struct {
  */
 int dotenv_load(const char *path, int replace, int apply_system_env);
 
+/**
+ * @brief Load a .env file only if it changed since the last call
+ * @param path Path to the .env file (NULL for ".env")
+ * @param replace 0=preserve existing variables, 1=replace existing
+ * @param apply_system_env 0=internal only, 1=apply to system environment
+ * @return Number of variables loaded (the previous count when the file is
+ * unchanged), negative error code on failure
+ * @note Meant for periodic polling: an unchanged file costs a stat() call and,
+ * when its metadata changed or is too recent to trust, one hash over the
+ * mapped content. Nothing is reparsed or re-applied to the environment.
+ */
+int dotenv_load_if_changed(const char *path, int replace,
+                           int apply_system_env);
+
 /**
  * @brief Load environment variables with advanced options
  * @param path Path to the .env file (NULL for ".env")
@@ -51,6 +84,23 @@ dotenv_error_t dotenv_load_ex(const char *path,
                               const dotenv_load_options_t *options,
                               dotenv_load_stats_t *stats);
 
+/**
+ * @brief Load a .env file and report counters and per-phase timings
+ * @param path Path to the .env file (NULL for ".env")
+ * @param options Pointer to load options structure (NULL for defaults)
+ * @param report Caller-allocated report whose struct_size is set to
+ * sizeof(dotenv_load_report_t); a library built with a newer layout fills
+ * only that many bytes, so older callers stay compatible
+ * @return DOTENV_SUCCESS on success, negative error code on failure
+ * (DOTENV_ERROR_INVALID_ARGUMENT if report is NULL or struct_size is too
+ * small to hold the header)
+ * @note The file is parsed in full and committed to the store in one batch;
+ * newline scanning is part of the parse phase, not timed separately.
+ */
+dotenv_error_t dotenv_load_report(const char *path,
+                                  const dotenv_load_options_t *options,
+                                  dotenv_load_report_t *report);
+
 /**
  * @brief Force traditional loading (no SIMD optimizations)
  * @param path Path to the .env file (NULL for ".env")
@@ -70,9 +120,43 @@ int dotenv_load_traditional(const char *path, int replace,
  * @return Variable value or default_value, never returns NULL (returns "" if
  * default is NULL)
  * @note Returned pointer is valid until next dotenv operation or program exit
+ * @warning A concurrent dotenv_set/dotenv_unset/dotenv_load of the same key
+ * frees the returned storage; use dotenv_snapshot_get() when other threads
+ * may modify the store
  */
 const char *dotenv_get(const char *key, const char *default_value);
 
+/* ==== Snapshot Functions ==== */
+
+/* Opaque handle to a pinned, read-only view of the internal store */
+typedef struct dotenv_snapshot dotenv_snapshot_t;
+
+/**
+ * @brief Pin the current state of the internal store
+ * @return Snapshot handle, or NULL on allocation failure
+ * @note Release with dotenv_snapshot_release()
+ */
+dotenv_snapshot_t *dotenv_snapshot_acquire(void);
+
+/**
+ * @brief Get variable value from a snapshot
+ * @param snapshot Snapshot handle from dotenv_snapshot_acquire()
+ * @param key Variable name to retrieve
+ * @param default_value Default value if variable not found (can be NULL)
+ * @return Variable value or default_value, never returns NULL (returns "" if
+ * default is NULL)
+ * @note Returned pointer is valid until the snapshot is released, regardless
+ * of concurrent modifications; the process environment is not consulted
+ */
+const char *dotenv_snapshot_get(const dotenv_snapshot_t *snapshot,
+                                const char *key, const char *default_value);
+
+/**
+ * @brief Release a snapshot handle (NULL is ignored)
+ * @param snapshot Snapshot handle from dotenv_snapshot_acquire()
+ */
+void dotenv_snapshot_release(dotenv_snapshot_t *snapshot);
+
 /**
  * @brief Get environment variable value with buffer
  * @param key Variable name to retrieve
@@ -185,9 +269,23 @@ typedef int (*dotenv_iterator_t)(const char *key, const char *value,
  * @param iterator Function to call for each variable
  * @param user_data Pointer passed to iterator function
  * @return Number of variables enumerated, or negative error code
+ * @note Iterates a pinned snapshot with no lock held: the iterator may call
+ * any dotenv function, and concurrent writes are not visible to it.
  */
 int dotenv_enumerate(dotenv_iterator_t iterator, void *user_data);
 
+/**
+ * @brief Enumerate the variables whose key starts with a prefix
+ * @param prefix Key prefix ("" enumerates every variable)
+ * @param iterator Function to call for each matching variable, in key order
+ * @param user_data Pointer passed to iterator function
+ * @return Number of variables enumerated, or negative error code
+ * @note Uses the sorted per-shard index of dotenv::entries_with_prefix():
+ * once built, the cost depends on the number of matches, not the store size.
+ */
+int dotenv_enumerate_prefix(const char *prefix, dotenv_iterator_t iterator,
+                            void *user_data);
+
 /**
  * @brief Clear all internally stored variables
  * @param clear_system 0=keep system environment, 1=also clear from system
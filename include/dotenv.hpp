@@ -4,13 +4,18 @@
 #include "dotenv_types.h"
 #include <cerrno>
 #include <charconv>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 // C++23 std::expected support (controlled by CMake detection)
 #ifndef DOTENV_HAS_EXPECTED
@@ -118,6 +123,39 @@ load_simd_legacy(std::string_view path = ".env",
                  const load_options &options = {}) noexcept;
 #endif
 
+/**
+ * @brief What a load did and where its time went
+ *
+ * Line counters come from the parser. Timings are wall-clock phases of a
+ * single load: open (map the file), parse (tokenize, including newline
+ * scanning and interpolation), commit (write into the store) and apply
+ * (copy into the process environment, zero when not requested).
+ */
+struct load_report {
+    int variables_loaded{}; // Definitions read (later duplicates included)
+    int lines_processed{};  // Physical lines seen, continuations included
+    int lines_skipped{};    // Blank and comment lines
+    int lines_rejected{};   // Lines without '=' or with an invalid key
+    int lines_too_long{};   // Lines skipped for exceeding the length limit
+    int values_truncated{}; // Values cut at the value length limit
+    std::chrono::nanoseconds open{};
+    std::chrono::nanoseconds parse{};
+    std::chrono::nanoseconds commit{};
+    std::chrono::nanoseconds apply{};
+    std::chrono::nanoseconds total{};
+};
+
+/**
+ * @brief Load a file like load_legacy() and report counters and timings
+ * @param path Path to the .env file
+ * @param options Load options; skip_if_unchanged and backend are ignored,
+ * the file is always parsed and committed to the store in one batch
+ * @return Error code and the report (zeroed on failure, except open)
+ */
+std::pair<dotenv_error, load_report>
+load_with_report(std::string_view path = ".env",
+                 const load_options &options = {}) noexcept;
+
 // Note: modern std::expected-based APIs are declared in the 'Modern Load'
 // section below (names: load, load_traditional, load_simd). The legacy
 // pair-returning APIs are available as *_legacy names.
@@ -246,6 +284,9 @@ void set(std::string_view key, std::string_view value, bool replace);
  * @param default_value Value to return if key not found
  * @return Variable value as string_view or default_value
  * @note Primary getter function - returns string_view for efficiency
+ * @warning The view points into the internal store and is invalidated by a
+ * concurrent set(), unset() or load() of the same key. Use dotenv::snapshot
+ * for zero-copy reads that must survive concurrent modification.
  */
 std::string_view get(std::string_view key, std::string_view default_value = "");
 
@@ -284,6 +325,29 @@ std::optional<std::string> try_value(std::string_view key) noexcept;
  */
 bool contains(std::string_view key);
 
+/**
+ * @brief Where a stored variable was defined
+ */
+struct source_location {
+    std::string file;       // Path as passed to the load function
+    std::uint32_t line{};   // 1-based line where the definition starts
+    std::uint32_t offset{}; // Byte offset of that line in the file
+};
+
+/**
+ * @brief Report the file, line and byte offset that defined a variable
+ * @param key Variable name to look up
+ * @return Location of the definition currently in the store, or
+ * std::nullopt if the key is not stored or was not loaded from a file
+ * (set(), process environment)
+ *
+ * Each entry records its origin as three 32-bit fields (an index into a
+ * table of loaded paths, the line and the offset) filled in by the parser,
+ * so for layered loads this names the layer whose value won. Entries loaded
+ * by load_directory() point at line 1 of their key file.
+ */
+[[nodiscard]] std::optional<source_location> where(std::string_view key);
+
 /**
  * @brief Set environment variable with type-safe overwrite policy
  * @param key Variable name
@@ -303,10 +367,620 @@ void unset(std::string_view key);
 /**
  * @brief Save current environment variables to file
  * @param path Path to save the .env file
+ * @param options Output order and incremental (layout-preserving) mode
+ * @throws std::runtime_error if the file cannot be written
  * @note Only saves internally managed variables (loaded from .env files) for
  * security
+ *
+ * Values are quoted where the parser would otherwise change them, so the
+ * file loads back to the same values. The file is replaced atomically: a
+ * temporary in the same directory is written, fsync'ed and renamed over
+ * `path`, and no store lock is held during the I/O. If `path` is a symlink,
+ * the file it points to is replaced and the link is kept.
+ *
+ * @note Values containing both ' and $ are written double-quoted with $ left
+ * as is, because \$ is only unescaped when interpolating. They round-trip
+ * with interpolation::none (the default) but are expanded when loaded back
+ * with interpolation::eager or lazy.
+ */
+void save_to_file(std::string_view path, const save_options &options = {});
+
+// ==== Snapshot API (Zero-Copy Reads) ====
+
+namespace detail {
+struct env_table;
+} // namespace detail
+
+/**
+ * @brief Pinned, read-only view of the internal store
+ *
+ * Acquiring a snapshot only takes a reference to the current table, so it is
+ * cheap. Writers never modify a table that is referenced by a snapshot (they
+ * copy it first), which keeps every string_view returned by the snapshot valid
+ * for the snapshot's lifetime, even while other threads call set(), unset()
+ * or reload configuration.
+ *
+ * @note Lookups only cover the internal store; unlike get(), there is no
+ * fallback to the process environment because that storage is not owned by
+ * the library.
+ * @note Keep snapshots short-lived on write-heavy workloads: each write to a
+ * pinned table copies it once.
+ */
+class snapshot {
+  public:
+    /**
+     * @brief Pin the current state of the internal store
+     */
+    snapshot();
+
+    /**
+     * @brief Look up a key in the pinned state
+     * @param key Variable name to retrieve
+     * @return View valid for the snapshot's lifetime, or std::nullopt
+     */
+    [[nodiscard]] std::optional<std::string_view>
+    find(std::string_view key) const noexcept;
+
+    /**
+     * @brief Get a value from the pinned state with fallback
+     * @param key Variable name to retrieve
+     * @param default_value Value to return if key not found
+     * @return View valid for the snapshot's lifetime, or default_value
+     */
+    [[nodiscard]] std::string_view
+    get(std::string_view key,
+        std::string_view default_value = "") const noexcept;
+
+    /**
+     * @brief Check if a key exists in the pinned state
+     */
+    [[nodiscard]] bool contains(std::string_view key) const noexcept;
+
+    /**
+     * @brief Number of variables in the pinned state
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Store generation observed when the snapshot was taken
+     * @note Two snapshots with the same generation see identical contents
+     */
+    [[nodiscard]] std::uint64_t generation() const noexcept {
+        return generation_;
+    }
+
+  private:
+    std::shared_ptr<const detail::env_table> table_;
+    std::uint64_t generation_{};
+};
+
+/**
+ * @brief Key and value of an entry_range element
+ */
+struct entry {
+    std::string_view key;
+    std::string_view value;
+};
+
+/**
+ * @brief Iterable, pinned view of every variable in the internal store
+ *
+ * Built from one pinned state, like dotenv::snapshot: iteration holds no
+ * lock, so a slow loop body never blocks readers or writers, and the views
+ * stay valid for the range's lifetime. Order is unspecified.
+ *
+ * @code
+ * for (auto [key, value] : dotenv::entries()) {
+ *     exporter.gauge(key, value);
+ * }
+ * @endcode
+ */
+class entry_range {
+  public:
+    using const_iterator = std::vector<entry>::const_iterator;
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return items_.begin();
+    }
+    [[nodiscard]] const_iterator end() const noexcept { return items_.end(); }
+    [[nodiscard]] size_t size() const noexcept { return items_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return items_.empty(); }
+
+    /**
+     * @brief Store generation the entries belong to
+     */
+    [[nodiscard]] std::uint64_t generation() const noexcept {
+        return generation_;
+    }
+
+  private:
+    friend class environment;
+    friend entry_range entries();
+
+    std::shared_ptr<const detail::env_table> table_;
+    std::vector<entry> items_;
+    std::uint64_t generation_{};
+};
+
+/**
+ * @brief Pin the internal store and list its variables
+ * @return Range of (key, value) views valid while the range exists
+ * @note Deferred (interpolation::lazy) values are expanded against the
+ * pinned state when the range is built.
+ */
+[[nodiscard]] entry_range entries();
+
+/**
+ * @brief Pin the internal store and list the variables under a prefix
+ * @param prefix Key prefix, e.g. "KAFKA_" ("" lists every variable)
+ * @return Matching entries sorted by key, valid while the range exists
+ *
+ * Each shard of a pinned state keeps a key-sorted index, built by the first
+ * prefix query after the shard changed and shared by later queries on the
+ * same state, so a lookup costs a binary search per shard plus the matches
+ * instead of a scan of the whole store.
+ */
+[[nodiscard]] entry_range entries_with_prefix(std::string_view prefix);
+
+// ==== Consistent Multi-Key Reads ====
+
+/**
+ * @brief Lookups inside a read_consistent() reader
+ *
+ * The first lookup in each shard of the store pins that shard's current
+ * table without taking the shard's lock, so returned views stay valid until
+ * the reader returns. Writers are never blocked by the read; one that writes
+ * a pinned shard copies its table first.
  */
-void save_to_file(std::string_view path);
+class view {
+  public:
+    /**
+     * @brief Look up a key
+     * @param key Variable name to retrieve
+     * @return View valid until the reader returns, or std::nullopt
+     */
+    [[nodiscard]] std::optional<std::string_view>
+    find(std::string_view key) const noexcept;
+
+    /**
+     * @brief Get a value with fallback
+     * @param key Variable name to retrieve
+     * @param default_value Value to return if key not found
+     * @return View valid until the reader returns, or default_value
+     */
+    [[nodiscard]] std::string_view
+    get(std::string_view key,
+        std::string_view default_value = "") const noexcept;
+
+    /**
+     * @brief Check if a key exists
+     */
+    [[nodiscard]] bool contains(std::string_view key) const noexcept;
+
+    view(const view &) = delete;
+    view &operator=(const view &) = delete;
+
+  private:
+    friend std::uint64_t
+    read_consistent(const std::function<void(const view &)> &reader);
+
+    explicit view(bool pin_all);
+    const detail::env_table *table_for(std::string_view key) const;
+    bool validated() const noexcept;
+    void reset() noexcept;
+
+    std::shared_ptr<detail::env_table> shards_; // Pinned per shard on demand
+    // Whole store, pinned for deferred values or after repeated retries;
+    // shards_ stays alive for views already returned
+    mutable std::shared_ptr<const detail::env_table> table_;
+    mutable std::uint64_t generation_{};
+};
+
+/**
+ * @brief Read a group of related keys as of a single store state
+ * @param reader Called with a view; may be called several times
+ * @return Store generation observed when the read was validated
+ *
+ * Each shard read is pinned with its generation; after the reader returns,
+ * only those shards are checked. If a writer changed one of them in between
+ * (set(), unset(), load(), reload()), the values may mix two states and the
+ * reader is called again; writes to keys in other shards do not cause a
+ * retry. After a few failed attempts the whole store is pinned, as
+ * dotenv::snapshot does, so the call always finishes under constant writes.
+ *
+ * @code
+ * std::string host, port;
+ * dotenv::read_consistent([&](const dotenv::view &env) {
+ *     host = env.get("DB_HOST");
+ *     port = env.get("DB_PORT");
+ * });
+ * @endcode
+ *
+ * @note Like dotenv::snapshot, only the internal store is consulted.
+ * @warning Keep the reader free of side effects other than assigning its
+ * results: a retried attempt runs it again from scratch.
+ */
+std::uint64_t read_consistent(const std::function<void(const view &)> &reader);
+
+// ==== Compiled Images (Precompiled .env) ====
+
+class mapped_file;
+
+namespace detail::image {
+struct layout;
+} // namespace detail::image
+
+/**
+ * @brief Compile a .env file into a binary image for load_compiled()
+ * @param source Path to the .env file
+ * @param output Path of the image to write (replaced atomically)
+ * @param options Only `expansion` is used; interpolation::lazy is compiled
+ * as interpolation::eager because the image is immutable
+ * @return dotenv_error::success or the error that stopped the compilation
+ *
+ * The image holds a header, an open-addressing hash index, a table of
+ * (hash, key, value) records sorted by key and a string pool where each
+ * value is NUL-terminated. It uses the byte order of the machine that
+ * compiled it; a foreign or corrupt image is rejected by load_compiled().
+ */
+dotenv_error compile(std::string_view source, std::string_view output,
+                     const load_options &options = {}) noexcept;
+
+/**
+ * @brief Read-only view of a compiled image, served from the mapping
+ *
+ * Lookups hash the key, probe the index and return views into the mapped
+ * string pool: nothing is parsed or copied. Copies share the same mapping,
+ * which stays alive while any copy exists. Independent of the internal
+ * store: set(), unset() and get() never see these values.
+ */
+class compiled_env {
+  public:
+    compiled_env() noexcept = default;
+
+    /**
+     * @brief Look up a key
+     * @return View into the mapping (NUL-terminated), or std::nullopt
+     */
+    [[nodiscard]] std::optional<std::string_view>
+    find(std::string_view key) const noexcept;
+
+    [[nodiscard]] std::string_view
+    get(std::string_view key,
+        std::string_view default_value = "") const noexcept;
+
+    [[nodiscard]] bool contains(std::string_view key) const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept { return entry_count_; }
+
+    /**
+     * @brief XXH64 of the .env file the image was compiled from
+     */
+    [[nodiscard]] std::uint64_t source_hash() const noexcept {
+        return source_hash_;
+    }
+
+    /**
+     * @brief Visit every entry in key order
+     */
+    void for_each(const std::function<void(std::string_view key,
+                                           std::string_view value)> &visitor)
+        const;
+
+  private:
+    friend std::pair<dotenv_error, compiled_env>
+    load_compiled(std::string_view path) noexcept;
+
+    [[nodiscard]] detail::image::layout view() const noexcept;
+
+    std::shared_ptr<const mapped_file> file_;
+    std::string_view index_;   // Hash buckets
+    std::string_view entries_; // Record table
+    std::string_view strings_; // String pool
+    size_t entry_count_{};
+    size_t bucket_count_{};
+    std::uint64_t source_hash_{};
+};
+
+/**
+ * @brief Map an image written by compile()
+ * @param path Path to the image
+ * @return Error status and the mapped view; invalid_format when the header,
+ * version, byte order or any offset does not match the file
+ * @note Validation reads the header, the index and the record table, and
+ * touches one byte of the string pool per record: the NUL that terminates
+ * each value. Keys and value bytes are not read.
+ */
+std::pair<dotenv_error, compiled_env>
+load_compiled(std::string_view path) noexcept;
+
+// ==== Shared Memory Store (One Publisher, Many Readers) ====
+
+/**
+ * @brief Publish the internal store to a named POSIX shared-memory segment
+ * @param name Segment name, with or without the leading '/'
+ * @param capacity Bytes reserved for the image when the segment is created
+ * (0 reserves twice the current image, at least 64 KiB); fixed afterwards
+ * @param mode Permission bits for a newly created segment (minus the umask);
+ * the default keeps the published values readable by the owner only. An
+ * existing segment keeps its permissions.
+ * @return success, or buffer_too_small when the image no longer fits the
+ * segment: unlink_shared() and publish again, then readers attach again
+ *
+ * The segment holds a small header with a seqlock sequence followed by the
+ * same position-independent image as compile(), so readers in other
+ * processes look keys up in place. Each publish rewrites the image between
+ * two increments of the sequence; concurrent publishers are serialized with
+ * an advisory file lock. Deferred values are published expanded.
+ */
+dotenv_error publish_shared(std::string_view name, size_t capacity = 0,
+                            unsigned int mode = 0600) noexcept;
+
+/**
+ * @brief Remove a shared-memory segment name; attached readers keep their
+ * mapping until they are destroyed
+ */
+dotenv_error unlink_shared(std::string_view name) noexcept;
+
+/**
+ * @brief Read-only attachment to a segment written by publish_shared()
+ *
+ * Lookups run against the shared mapping without locks: the reader records
+ * the sequence, reads, and retries if a publish started or finished in the
+ * meantime. Values are returned as copies because the publisher may rewrite
+ * the mapping right after the read. Copies of a shared_env share the mapping.
+ *
+ * A publisher that dies mid-publication leaves the segment marked as being
+ * written until the next publish_shared(). Lookups wait at most 250 ms for
+ * it, then throw std::system_error with std::errc::timed_out rather than
+ * spin forever.
+ */
+class shared_env {
+  public:
+    shared_env() noexcept = default;
+
+    /**
+     * @brief Look up a key in the latest complete publication
+     */
+    [[nodiscard]] std::optional<std::string> find(std::string_view key) const;
+
+    [[nodiscard]] std::string get(std::string_view key,
+                                  std::string_view default_value = "") const;
+
+    [[nodiscard]] bool contains(std::string_view key) const;
+
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Number of publications completed so far
+     */
+    [[nodiscard]] std::uint64_t version() const noexcept;
+
+  private:
+    struct segment;
+
+    friend std::pair<dotenv_error, shared_env>
+    attach_shared(std::string_view name) noexcept;
+
+    std::shared_ptr<const segment> segment_;
+};
+
+/**
+ * @brief Attach read-only to a published segment
+ * @return file_not_found until the segment exists and was published once;
+ * invalid_format if it is not a dotenv segment
+ */
+std::pair<dotenv_error, shared_env>
+attach_shared(std::string_view name) noexcept;
+
+// ==== Reload and Change Notification ====
+
+/**
+ * @brief Keys affected by a reload, each list sorted
+ */
+struct change_set {
+    std::vector<std::string> added;   // Keys that were not in the store
+    std::vector<std::string> removed; // Keys dropped from the source file
+    std::vector<std::string> changed; // Keys whose value differs
+
+    [[nodiscard]] bool empty() const noexcept {
+        return added.empty() && removed.empty() && changed.empty();
+    }
+};
+
+/**
+ * @brief Observer callback; receives only the keys matching its prefix
+ */
+using change_callback = std::function<void(const change_set &changes)>;
+
+/**
+ * @brief Registration returned by subscribe(); unsubscribes when destroyed
+ */
+class subscription {
+  public:
+    subscription() noexcept = default;
+    ~subscription() { reset(); }
+
+    subscription(const subscription &) = delete;
+    subscription &operator=(const subscription &) = delete;
+    subscription(subscription &&other) noexcept
+        : id_(std::exchange(other.id_, 0)) {}
+    subscription &operator=(subscription &&other) noexcept {
+        if (this != &other) {
+            reset();
+            id_ = std::exchange(other.id_, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Unsubscribe now
+     * @note A notification already being delivered on another thread may
+     * still complete after this returns
+     */
+    void reset() noexcept;
+
+    [[nodiscard]] bool active() const noexcept { return id_ != 0; }
+
+  private:
+    friend subscription subscribe(std::string_view, change_callback);
+    explicit subscription(std::uint64_t id) noexcept : id_(id) {}
+
+    std::uint64_t id_{0};
+};
+
+/**
+ * @brief Register an observer for changes applied by reload() and watch()
+ * @param key_prefix Only keys starting with this prefix are delivered ("" for
+ * all keys)
+ * @param callback Invoked with the matching subset of each non-empty change
+ * @return Subscription that keeps the observer registered
+ * @note Callbacks run on the thread that applied the change, after the store
+ * locks were released, so they may read or modify the store freely.
+ * Exceptions thrown by callbacks are swallowed.
+ */
+[[nodiscard]] subscription subscribe(std::string_view key_prefix,
+                                     change_callback callback);
+
+/**
+ * @brief Reload a .env file and report what changed
+ * @param path Path to the .env file
+ * @param options Overwrite and process environment policies
+ * @return Error status and the added/removed/changed keys
+ *
+ * The file is parsed into a private map, compared with the current store and
+ * committed in a single batch. Keys the store holds from this path (written
+ * by load(), load_layers(), a previous reload() or watch()) that the file no
+ * longer defines are removed. Subscribers are notified after the store locks
+ * are released.
+ *
+ * A key this file wrote is only replaced or removed while the store still
+ * holds the value it wrote; keys changed since by set() or another load keep
+ * their new value. With overwrite::preserve, process variables are only
+ * replaced or unset when they still hold the value this file wrote.
+ */
+std::pair<dotenv_error, change_set>
+reload(std::string_view path = ".env",
+       const load_options &options = {}) noexcept;
+
+/**
+ * @brief Load several .env files as layers of one configuration
+ * @param paths Files in increasing precedence, e.g. {".env",
+ * ".env.production", ".env.local"}; a key defined by a later layer overrides
+ * earlier ones
+ * @param options Policies for the merged result; with parallel_parse the
+ * layers are parsed concurrently
+ * @return Error status and the number of distinct keys merged
+ *
+ * Every layer is mapped and parsed before the store is touched, the merged
+ * result is committed in a single batch and, when requested, only the merged
+ * keys are applied to the process environment, once. Missing layers are
+ * skipped; file_not_found is returned only when none exists. Any other error
+ * leaves the store unchanged.
+ *
+ * @note With interpolation::eager, a reference resolves to the same layer,
+ * then to the earlier layers, then to the store and the process environment;
+ * lazy templates are expanded against the merged store when read. A self
+ * reference (PATH=${PATH}:/opt/bin) sees the value of the earlier layers.
+ * @note skip_if_unchanged is ignored.
+ */
+std::pair<dotenv_error, int>
+load_layers(const std::vector<std::string> &paths,
+            const load_options &options = {}) noexcept;
+
+/**
+ * @brief Load a directory with one file per variable (Kubernetes Secret or
+ * ConfigMap volume mounts)
+ * @param path Directory to enumerate
+ * @param options Overwrite and process environment policies;
+ * strip_trailing_newline removes one line ending from each value
+ * @return Error status and the number of files loaded
+ *
+ * Each regular file (symlinks are followed) becomes key = file name,
+ * value = file contents, stored verbatim: no parsing and no interpolation.
+ * Names starting with '.' (including the "..data" entries of Kubernetes
+ * mounts) or containing '=' are skipped. Small files are read with a single
+ * pread(), larger ones are memory-mapped, and all values are committed in
+ * one batch. A file that cannot be read aborts the load with the store
+ * unchanged; files removed while loading are skipped.
+ */
+std::pair<dotenv_error, int>
+load_directory(std::string_view path,
+               const load_options &options = {}) noexcept;
+
+// ==== File Watching (Hot Reload) ====
+
+/**
+ * @brief Callback invoked after a watched file was reloaded
+ * @param changed_keys Keys added, modified or removed by the reload, sorted
+ * @note Runs on the watcher thread, after the store locks were released
+ */
+using watch_callback =
+    std::function<void(const std::vector<std::string> &changed_keys)>;
+
+/**
+ * @brief Owner of a running file watch; stops watching when destroyed
+ */
+class watch_handle {
+  public:
+    watch_handle() noexcept;
+    ~watch_handle();
+
+    watch_handle(const watch_handle &) = delete;
+    watch_handle &operator=(const watch_handle &) = delete;
+    watch_handle(watch_handle &&other) noexcept;
+    watch_handle &operator=(watch_handle &&other) noexcept;
+
+    /**
+     * @brief Stop watching and join the watcher thread
+     * @note Safe to call more than once; must not be called from the callback
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Check if the watch is still running
+     */
+    [[nodiscard]] bool active() const noexcept;
+
+  private:
+    struct watcher;
+
+    friend watch_handle watch(std::string_view, const load_options &,
+                              watch_callback, std::chrono::milliseconds);
+    explicit watch_handle(std::unique_ptr<watcher> impl) noexcept;
+
+    std::unique_ptr<watcher> impl_;
+};
+
+/**
+ * @brief Load a .env file and reload it whenever it changes
+ * @param path Path to the .env file (its directory must exist)
+ * @param options Overwrite and process environment policies for every reload
+ * @param callback Called with the changed keys after each effective reload
+ * @param debounce Quiet period after the last event before reparsing
+ * @return Handle that keeps the watch alive
+ * @throws std::system_error if the watch cannot be set up
+ *
+ * The file is loaded once before returning. Changes are detected with inotify
+ * on the parent directory, so in-place writes and atomic rename-replace (as
+ * done by editors and configuration management tools) are both picked up.
+ * Bursts of events are coalesced: the file is reparsed on a background thread
+ * only after @p debounce elapses without new events (or, under a steady
+ * stream of events, at most 10 × @p debounce after the first one of the
+ * burst), and the new contents are
+ * committed to the store in one batch, so readers and snapshots see either
+ * the previous or the new file, never a mix. Keys that disappear from the file
+ * are removed. If the file is missing or unreadable, the last good contents
+ * stay in place. Observers registered with subscribe() are notified after
+ * @p callback.
+ *
+ * @note Linux only; other platforms throw std::system_error with
+ * std::errc::function_not_supported.
+ */
+[[nodiscard]] watch_handle
+watch(std::string_view path, const load_options &options,
+      watch_callback callback,
+      std::chrono::milliseconds debounce = std::chrono::milliseconds{50});
 
 // ==== Numeric Type Conversion Templates ====
 
@@ -469,6 +1143,194 @@ inline std::expected<T, dotenv_error> value_expected(std::string_view key) {
 }
 #endif // DOTENV_HAS_STD_EXPECTED
 
+// ==== Isolated Environments ====
+
+namespace detail {
+struct environment_state;
+} // namespace detail
+
+/**
+ * @brief Whether an environment reads and writes the process environment
+ */
+enum class process_env_fallback {
+    no, ///< Only the environment's own store is consulted and updated
+    yes ///< Lookups fall back to it and loads may apply to it (default)
+};
+
+/**
+ * @brief Independent store with the core load, read and write API
+ *
+ * Each instance owns its own sharded store, lazy-expansion cache and
+ * skip_if_unchanged bookkeeping, so separate instances (one per tenant,
+ * one per test) never share values or locks. The free functions (load(),
+ * get(), set(), save_to_file(), entries(), ...) operate on
+ * default_environment().
+ *
+ * By default lookups and interpolation fall back to the process environment
+ * like the free functions do, and loads apply to it unless
+ * load_options::apply_to_process is process_env_apply::no. An instance
+ * created with process_env_fallback::no neither reads nor writes the process
+ * environment, which is what isolated instances usually want.
+ * Reloads, watches, snapshots, consistent reads and subscriptions only
+ * operate on the default environment.
+ *
+ * @code
+ * dotenv::environment tenant(dotenv::process_env_fallback::no);
+ * tenant.load_layers({"tenants/base.env", "tenants/acme.env"});
+ * auto pool_size = tenant.value_or<int>("DB_POOL_SIZE", 8);
+ * @endcode
+ */
+class environment {
+  public:
+    /**
+     * @brief Create an empty environment that falls back to the process
+     * environment
+     */
+    environment();
+
+    /**
+     * @brief Create an empty environment
+     * @param fallback process_env_fallback::no keeps the instance away from
+     * the process environment: lookups and interpolation only see this
+     * instance, and loads never apply to the process, whatever
+     * load_options::apply_to_process says
+     */
+    explicit environment(process_env_fallback fallback);
+    ~environment();
+
+    // Views returned by get() and entries() point into the instance
+    environment(const environment &) = delete;
+    environment &operator=(const environment &) = delete;
+
+    /**
+     * @brief Load a .env file into this environment
+     * @param path Path to the .env file
+     * @param options Same options as the free load functions
+     * @return Error code and number of variables loaded
+     * @note The file is staged and committed in one batch; on failure the
+     * environment is left untouched.
+     */
+    std::pair<dotenv_error, int>
+    load(std::string_view path = ".env",
+         const load_options &options = {}) noexcept;
+
+    /**
+     * @brief Load layered .env files into this environment, as
+     * dotenv::load_layers()
+     */
+    std::pair<dotenv_error, int>
+    load_layers(const std::vector<std::string> &paths,
+                const load_options &options = {}) noexcept;
+
+    /**
+     * @brief Load a directory with one file per variable into this
+     * environment, as dotenv::load_directory()
+     */
+    std::pair<dotenv_error, int>
+    load_directory(std::string_view path,
+                   const load_options &options = {}) noexcept;
+
+    /**
+     * @brief Get a value with fallback
+     * @warning Like dotenv::get(), the view is invalidated by a concurrent
+     * set(), unset() or load() of the same key on this environment.
+     */
+    [[nodiscard]] std::string_view
+    get(std::string_view key, std::string_view default_value = "") const;
+
+    /**
+     * @brief Get a value as an owned string with fallback
+     */
+    [[nodiscard]] std::string
+    value(std::string_view key, std::string_view default_value = "") const;
+
+    /**
+     * @brief Get a value as an owned string with fallback (never throws on
+     * a missing key)
+     */
+    [[nodiscard]] std::string value_or(std::string_view key,
+                                       std::string_view fallback_value) const;
+
+    /**
+     * @brief Get a numeric value, or `fallback_value` if the key is missing
+     * or does not convert to T
+     */
+    template <class T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    [[nodiscard]] T value_or(std::string_view key,
+                             T fallback_value) const noexcept {
+        auto stored = try_value(key);
+        T result{};
+        if (!stored || !parse_arithmetic_from_string<T>(*stored, result)) {
+            return fallback_value;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get a value, or std::nullopt if the key is missing
+     */
+    [[nodiscard]] std::optional<std::string>
+    try_value(std::string_view key) const noexcept;
+
+    /**
+     * @brief Check if a key exists (here or in the process environment)
+     */
+    [[nodiscard]] bool contains(std::string_view key) const;
+
+    /**
+     * @brief Set a value in this environment only
+     */
+    void set(std::string_view key, std::string_view value,
+             overwrite overwrite_policy = overwrite::replace);
+
+    /**
+     * @brief Remove a key from this environment
+     */
+    void unset(std::string_view key);
+
+    /**
+     * @brief Remove every key from this environment
+     * @note The process environment is not touched.
+     */
+    void clear();
+
+    /**
+     * @brief Save this environment's variables, as dotenv::save_to_file()
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save_to_file(std::string_view path,
+                      const save_options &options = {}) const;
+
+    /**
+     * @brief Pin this environment and list its variables
+     * @return Range of (key, value) views valid while the range exists
+     */
+    [[nodiscard]] entry_range entries() const;
+
+    /**
+     * @brief Pin this environment and list the variables under a prefix,
+     * as dotenv::entries_with_prefix()
+     */
+    [[nodiscard]] entry_range
+    entries_with_prefix(std::string_view prefix) const;
+
+  private:
+    friend environment &default_environment() noexcept;
+
+    // Default instance: views the global state without owning it
+    explicit environment(detail::environment_state &shared) noexcept;
+
+    std::unique_ptr<detail::environment_state> owned_; // null if shared
+    detail::environment_state *state_;
+};
+
+/**
+ * @brief The environment behind the free functions
+ * @return Process-wide instance; dotenv::set(k, v) and
+ * default_environment().set(k, v) are the same operation
+ */
+[[nodiscard]] environment &default_environment() noexcept;
+
 // ==== Legacy API Compatibility (Minimal Deprecated Aliases) ====
 
 /**
@@ -0,0 +1,15 @@
+#pragma once
+
+/* Error codes shared by the C API and dotenv::dotenv_error (same values) */
+typedef enum {
+    DOTENV_SUCCESS = 0,                  /* Operation successful */
+    DOTENV_ERROR_FILE_NOT_FOUND = -1,    /* .env file not found */
+    DOTENV_ERROR_PERMISSION_DENIED = -2, /* Permission denied */
+    DOTENV_ERROR_INVALID_FORMAT = -3,    /* Invalid file format */
+    DOTENV_ERROR_OUT_OF_MEMORY = -4,     /* Insufficient memory */
+    DOTENV_ERROR_INVALID_ARGUMENT = -5,  /* Invalid argument */
+    DOTENV_ERROR_BUFFER_TOO_SMALL = -6,  /* Buffer too small */
+    DOTENV_ERROR_KEY_NOT_FOUND = -7,     /* Key not found in environment */
+    DOTENV_ERROR_LIMIT_EXCEEDED = -8     /* Input exceeded a configured limit
+                                            (load options, limits or budget) */
+} dotenv_error_t;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
@@ -30,6 +32,17 @@ constexpr inline size_t AVX2_ALIGNMENT = 32;
 [[nodiscard]] auto count_lines_avx2(std::string_view content,
                                     char delimiter = '\n') noexcept -> size_t;
 
+/**
+ * @brief Find the next newline using AVX2 32-byte comparisons
+ * @param content Content to scan
+ * @param from Position where the search starts
+ * @return Position of the next '\n', or std::string_view::npos
+ * @note Signature matches the line-end search hook of the shared parser, so
+ * both backends parse with the same state machine
+ */
+[[nodiscard]] auto find_newline_avx2(std::string_view content,
+                                     size_t from) noexcept -> size_t;
+
 /**
  * @brief Memory-efficient callback-based line processing with SIMD optimization
  *
@@ -74,33 +87,24 @@ process_lines_avx2(std::string_view content, char delimiter,
         const auto cmp = _mm256_cmpeq_epi8(mem, line_feed);
         auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(cmp));
 
-        if (mask != 0) {
-            const auto found_lines =
-                static_cast<unsigned int>(std::popcount(mask));
-            size_t relative_pos = i;
-
-            for (unsigned int line_idx = 0; line_idx < found_lines;
-                 ++line_idx) {
-                const auto pos =
-                    static_cast<unsigned int>(std::countr_zero(mask));
-                const auto abs_pos = relative_pos + pos;
-
-                // Ensure we don't go beyond the content
-                if (abs_pos < content.size()) {
-                    const auto *line_end = content.data() + abs_pos;
-                    const auto line_size =
-                        static_cast<size_t>(line_end - current_line);
-
-                    // Call the callback immediately with the line
-                    callback(line_count,
-                             std::string_view(current_line, line_size));
-                    current_line = content.data() + abs_pos +
-                                   1; // Safe pointer calculation
-                    ++line_count;
-                }
-
-                relative_pos += pos + 1;
-                mask >>= pos + 1;
+        // Clear the lowest set bit per line: no shift by the full width
+        while (mask != 0) {
+            const auto abs_pos =
+                i + static_cast<size_t>(std::countr_zero(mask));
+            mask &= mask - 1;
+
+            // Ensure we don't go beyond the content
+            if (abs_pos < content.size()) {
+                const auto *line_end = content.data() + abs_pos;
+                const auto line_size =
+                    static_cast<size_t>(line_end - current_line);
+
+                // Call the callback immediately with the line
+                callback(line_count,
+                         std::string_view(current_line, line_size));
+                current_line = content.data() + abs_pos +
+                               1; // Safe pointer calculation
+                ++line_count;
             }
         }
     }
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <string_view>
+
+namespace dotenv {
+
+/**
+ * @brief Error codes for the C++ API
+ * @note Values mirror dotenv_error_t so conversions are a plain cast
+ */
+enum class dotenv_error {
+    success = 0,            // Operation successful
+    file_not_found = -1,    // .env file not found
+    permission_denied = -2, // Permission denied
+    invalid_format = -3,    // Invalid file format
+    out_of_memory = -4,     // Insufficient memory
+    invalid_argument = -5,  // Invalid argument
+    buffer_too_small = -6,  // Buffer too small
+    key_not_found = -7,     // Key not found in environment
+    limit_exceeded = -8     // Input exceeds load_options::limits or ::budget
+};
+
+/**
+ * @brief Policy for variables that already exist
+ */
+enum class overwrite {
+    preserve, // Don't overwrite existing variables
+    replace   // Replace existing variables (default)
+};
+
+/**
+ * @brief Whether loaded variables are applied to the process environment
+ */
+enum class process_env_apply {
+    no, // Keep variables internal only (safe)
+    yes // Apply to system environment (default)
+};
+
+/**
+ * @brief Parser backend selection
+ */
+enum class parse_backend {
+    auto_detect, // Automatically choose best backend (default)
+    traditional, // Force traditional parser
+    simd         // Force SIMD parser (if available)
+};
+
+/**
+ * @brief Variable interpolation in loaded values
+ *
+ * Supported references: ${VAR}, $VAR and ${VAR:-default} (default used when
+ * VAR is unset or empty; it may contain references itself). Write \$ for a
+ * literal dollar sign; single-quoted values are never expanded.
+ */
+enum class interpolation {
+    none,  // Store values literally (default)
+    eager, // Expand every value once, after the whole file is parsed
+    lazy   // Store templates; expand each value on first read and cache it
+};
+
+/**
+ * @brief Why the parser skipped or altered a line
+ */
+enum class diagnostic_code {
+    line_too_long,     // Line exceeds the length limit; skipped
+    missing_separator, // Non-comment line without '='; skipped
+    invalid_key,       // Key is empty, too long or has invalid characters
+    value_truncated,   // Value cut at the value length limit; still loaded
+    too_many_entries   // Entry limit reached; the rest of the file is ignored
+};
+
+/**
+ * @brief One problem found while parsing a file
+ */
+struct diagnostic {
+    std::string_view file; // Path being loaded; valid during the callback
+    std::size_t line{};    // 1-based line of the offending definition
+    std::size_t column{};  // 1-based byte column within that line
+    diagnostic_code code{};
+};
+
+/**
+ * @brief Receives diagnostics synchronously, during the load
+ *
+ * load_layers() with parallel_parse calls it from the parse threads, one
+ * call at a time; watch() calls it from the watcher thread.
+ */
+using diagnostic_sink = std::function<void(const diagnostic &)>;
+
+/**
+ * @brief Size limits applied while parsing
+ *
+ * The defaults are the library's historical limits, and loads using them
+ * run a parser specialized for those constant bounds. Raise them for large
+ * values such as certificate chains, or lower them to bound the memory an
+ * untrusted file can make a load use.
+ */
+struct parse_limits {
+    // Physical lines longer than this are skipped
+    std::size_t max_line_length = 8192;
+    // Keys longer than this are rejected
+    std::size_t max_key_length = 256;
+    // Values longer than this are truncated
+    std::size_t max_value_length = 4096;
+    // Larger files fail with dotenv_error::limit_exceeded before parsing
+    std::size_t max_file_size = std::numeric_limits<std::size_t>::max();
+    // Definitions past this count are ignored (reported as too_many_entries)
+    std::size_t max_entries = std::numeric_limits<std::size_t>::max();
+
+    friend bool operator==(const parse_limits &,
+                           const parse_limits &) = default;
+};
+
+/**
+ * @brief Total work a single load may do
+ *
+ * Meant for untrusted files: when any budget runs out, the load stops and
+ * returns dotenv_error::limit_exceeded without touching the store. A load
+ * with a budget is always parsed in full before its single batch commit.
+ */
+struct load_budget {
+    // Bytes of keys and values held before the commit, expansions included
+    std::size_t max_memory = std::numeric_limits<std::size_t>::max();
+    // Physical lines read, across every layer of load_layers()
+    std::size_t max_lines = std::numeric_limits<std::size_t>::max();
+    // Wall-clock time for parsing and eager interpolation
+    std::chrono::nanoseconds max_duration = std::chrono::nanoseconds::max();
+
+    friend bool operator==(const load_budget &,
+                           const load_budget &) = default;
+};
+
+/**
+ * @brief Type-safe configuration for the load functions
+ */
+struct load_options {
+    overwrite overwrite_policy = overwrite::replace;
+    process_env_apply apply_to_process = process_env_apply::yes;
+    parse_backend backend = parse_backend::auto_detect;
+    /**
+     * @brief Return the previous count without reparsing when the file did
+     * not change since the last load made with this flag
+     *
+     * The file is identified by (device, inode, size, mtime); when that
+     * metadata differs, or the mtime is too recent to be trusted, a 64-bit
+     * content hash over the mapped file decides. A load with different
+     * overwrite/apply policies, or after dotenv_clear(), always reparses.
+     */
+    bool skip_if_unchanged = false;
+    /**
+     * @brief Expand references between values
+     *
+     * References resolve first to other keys of the same file (each value is
+     * expanded once, in dependency order), then to the internal store, then
+     * to the process environment; unknown names expand to an empty string. A
+     * key referencing itself (PATH=${PATH}:/opt/bin) sees its previous value.
+     * References that form a cycle are treated as unset. A chain of more
+     * than 256 nested references fails the load with
+     * dotenv_error::limit_exceeded (with lazy, the reference past the limit
+     * reads as unset).
+     *
+     * With interpolation::lazy, loading only stores the templates (self
+     * references are bound at load time). A value is expanded on its first
+     * read and cached; set(), unset(), loads and reloads of a key invalidate
+     * the cached expansions that read it. Process-environment fallbacks are
+     * read at expansion time. Applying to the process environment expands
+     * every value, so pair lazy with process_env_apply::no.
+     */
+    interpolation expansion = interpolation::none;
+    /**
+     * @brief load_layers(): parse the layers on separate threads
+     *
+     * Only worth it for several large files; merging, expansion and the store
+     * commit stay on the calling thread. Ignored by the single-file loads.
+     */
+    bool parallel_parse = false;
+    /**
+     * @brief load_directory(): drop one trailing "\n" or "\r\n" from each
+     * file, as left by `echo value > file`
+     */
+    bool strip_trailing_newline = false;
+    /**
+     * @brief Called for every line the parser skips or alters
+     *
+     * Empty by default, in which case nothing is reported and the parser
+     * only pays a branch on the rejected paths. Nothing is written to
+     * stderr either way; route diagnostics to a logger from here.
+     */
+    diagnostic_sink on_diagnostic{};
+    /**
+     * @brief Line, key, value, file size and entry count limits
+     *
+     * Honored by both backends and by load_layers() (per layer), reload()
+     * and watch(), which keeps the current state when the file grows past
+     * max_file_size. load_directory() only applies max_file_size, to each
+     * file.
+     */
+    parse_limits limits{};
+    /**
+     * @brief Memory, line and time budget for the whole load
+     *
+     * Honored by every loader that parses (including load_layers(),
+     * reload() and watch(), which keeps the current state); ignored by
+     * load_directory(). Unlimited by default.
+     */
+    load_budget budget{};
+    /**
+     * @brief Fail the whole load on any line the parser skips or alters
+     *
+     * Every line that would produce a diagnostic (see on_diagnostic, which
+     * still receives all of them) makes the load return
+     * dotenv_error::invalid_format with nothing committed to the store or
+     * the process environment. reload() and watch() keep the current state.
+     * Comments and blank lines are not affected.
+     */
+    bool strict = false;
+};
+
+/**
+ * @brief Configuration for save_to_file()
+ */
+struct save_options {
+    /**
+     * @brief Write entries in key order, so repeated saves of the same state
+     * produce identical files
+     */
+    bool sorted = false;
+    /**
+     * @brief Patch an existing file instead of rewriting it from scratch
+     *
+     * Comments, blank lines and the original text of unchanged definitions
+     * are kept; changed values are rewritten in place, definitions of keys
+     * no longer in the store are dropped and new keys are appended in key
+     * order. When nothing changed, the file is not written at all.
+     */
+    bool preserve_layout = false;
+};
+
+} // namespace dotenv
@@ -1,10 +1,18 @@
 #include "dotenv.hpp"
 #include "dotenv.h"
+#include "dotenv_budget.hpp"
+#include "dotenv_fingerprint.hpp"
+#include "dotenv_interpolate.hpp"
+#include "dotenv_mmap.hpp"
+#include "dotenv_parser.hpp"
+#include "dotenv_store.hpp"
 #include "dotenv_types.h"
+#include "dotenv_writer.hpp"
 #include <algorithm>
 #include <cctype>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #if DOTENV_HAS_STD_EXPECTED
@@ -12,16 +20,20 @@
 #endif
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iomanip>
-#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #ifdef DOTENV_SIMD_ENABLED
-#include "dotenv_mmap.hpp"
 #include "dotenv_simd.hpp"
 #endif
 
@@ -106,6 +118,12 @@ static int set_env(const char *key, const char *value, int replace) {
     return _wputenv_s(wide_key.c_str(), wide_value.c_str());
 }
 
+// Remove a variável do ambiente do processo (valor vazio remove no Windows)
+static int unset_env(const char *key) {
+    std::wstring wide_key = utf8_to_utf16(key);
+    return _wputenv_s(wide_key.c_str(), L"");
+}
+
 // Função para carregar ambiente do Windows usando Unicode
 /*
 static void load_windows_environment(std::unordered_map<std::string,
@@ -149,6 +167,8 @@ static auto set_env(const char *key, const char *value, int replace) -> int {
     return setenv(key, value, replace);
 }
 
+static auto unset_env(const char *key) -> int { return unsetenv(key); }
+
 // Função para carregar ambiente POSIX
 /*
 static void load_posix_environment(std::unordered_map<std::string, std::string>&
@@ -178,177 +198,460 @@ static auto split_once(std::string_view strview, std::string_view delimiter)
             StrType(strview.substr(pos + delimiter.size()))};
 }
 
-// Função para remover espaços em branco no início e fim
-static auto trim(std::string_view str) -> std::string_view {
-    const auto start = str.find_first_not_of(" \t\r\n");
-    if (start == std::string_view::npos) {
-        return {};
-    }
-    const auto end = str.find_last_not_of(" \t\r\n");
-    return str.substr(start, end - start + 1);
+// Threshold baseado em dados empíricos: SIMD só vale a pena para arquivos >50KB
+static constexpr size_t MIN_FILE_SIZE_FOR_SIMD =
+    static_cast<const size_t>(50U * 1024U);
+
+// Declarações antecipadas das implementações de cada backend
+static auto
+load_traditional_implementation(dotenv::detail::environment_state &env,
+                                std::string_view path,
+                                const dotenv::load_options &options) noexcept
+    -> int;
+#ifdef DOTENV_SIMD_ENABLED
+static auto
+load_simd_implementation(dotenv::detail::environment_state &env,
+                         std::string_view path,
+                         const dotenv::load_options &options) noexcept -> int;
+#endif
+
+// Opções equivalentes aos parâmetros das funções *_raw
+static auto raw_options(int replace, bool apply_system_env)
+    -> dotenv::load_options {
+    return {.overwrite_policy = (replace != 0) ? dotenv::overwrite::replace
+                                               : dotenv::overwrite::preserve,
+            .apply_to_process = apply_system_env
+                                    ? dotenv::process_env_apply::yes
+                                    : dotenv::process_env_apply::no};
 }
 
-// Função para processar aspas e escape básico
-static auto process_quoted_value(std::string_view value) -> std::string {
-    auto trimmed = trim(value);
+// Tudo o que uma dotenv::environment guarda
+struct dotenv::detail::environment_state {
+    // Última carga de cada arquivo feita com skip_if_unchanged
+    struct tracked_file {
+        file_fingerprint fingerprint;
+        int count{};
+        bool replace{};
+        bool apply_system_env{};
+        interpolation expansion{};
+        // Validação feita pela carga: um skip só vale para opções iguais
+        parse_limits limits{};
+        load_budget budget{};
+        bool strict{};
+    };
 
-    // Se não tem aspas, retorna como está
-    if (trimmed.size() < 2) {
-        return std::string(trimmed);
-    }
+    // Store seguro que possui a memória das strings e sincronização para
+    // threads
+    env_store store;
+    // Expansões dos valores adiados (interpolation::lazy) do store
+    expansion_cache expansions;
+    std::mutex tracked_mutex;
+    std::unordered_map<std::string, tracked_file, string_hash,
+                       std::equal_to<>>
+        tracked;
+    // O que cada arquivo gravou no store na última recarga, por reload() ou
+    // watch()
+    std::mutex reload_mutex;
+    std::unordered_map<std::string, env_map, string_hash, std::equal_to<>>
+        reload_sources;
+    // false com process_env_fallback::no: o ambiente do processo não é
+    // consultado nem atualizado
+    bool process_env{true};
+};
 
-    // Verifica se está entre aspas simples ou duplas
-    char quote_char = '\0';
-    if ((trimmed.front() == '"' && trimmed.back() == '"') ||
-        (trimmed.front() == '\'' && trimmed.back() == '\'')) {
-        quote_char = trimmed.front();
-        trimmed = trimmed.substr(1, trimmed.size() - 2); // Remove aspas
+namespace {
+
+using dotenv::detail::env_map;
+using dotenv::detail::environment_state;
+using dotenv::detail::pinned_value;
+using dotenv::detail::ValueStruct;
+
+// Instância padrão, usada pelas funções livres
+environment_state defaultState;
+// Atalhos para as APIs que só existem na instância padrão (reload, camadas,
+// snapshots, API C)
+auto &envStore = defaultState.store;
+auto &expansionCache = defaultState.expansions;
+
+// Adapta `sink` ao callback do parser, com `file` em cada diagnóstico; vazio
+// sem sink, para que o parser não pague nada. `sink` e `file` precisam viver
+// até o fim da análise.
+auto issue_reporter(const dotenv::diagnostic_sink &sink, std::string_view file)
+    -> dotenv::detail::issue_callback {
+    if (!sink) {
+        return {};
     }
+    return [&sink, file](size_t line, size_t column,
+                         dotenv::diagnostic_code code) {
+        sink({.file = file, .line = line, .column = column, .code = code});
+    };
+}
+
+// issue_reporter de options.on_diagnostic; com options.strict também marca
+// `rejected` a cada linha ignorada ou alterada
+auto checked_reporter(const dotenv::load_options &options,
+                      std::string_view file, bool &rejected)
+    -> dotenv::detail::issue_callback {
+    auto report = issue_reporter(options.on_diagnostic, file);
+    if (!options.strict) {
+        return report;
+    }
+    return [report = std::move(report), &rejected](
+               size_t line, size_t column, dotenv::diagnostic_code code) {
+        rejected = true;
+        if (report) {
+            report(line, column, code);
+        }
+    };
+}
 
-    // Se não tinha aspas, retorna trimmed
-    if (quote_char == '\0') {
-        return std::string(trimmed);
+// Mapeia o arquivo de origem; 0 em caso de sucesso, -1 se não existir, -2
+// se existir mas não puder ser lido e -8 se passar de `max_size` bytes
+auto map_source(const std::string &path, dotenv::mapped_file &file,
+                size_t max_size = std::numeric_limits<size_t>::max()) -> int {
+    if (file.map(path)) {
+        if (file.view().size() > max_size) {
+            file.close();
+            return -8;
+        }
+        return 0;
     }
+    std::error_code error_code;
+    return std::filesystem::exists(path, error_code) ? -2 : -1;
+}
 
-    // Processa escape básico apenas para aspas duplas
-    std::string result;
-    result.reserve(trimmed.size());
+} // namespace
 
-    for (size_t i = 0; i < trimmed.size(); ++i) {
-        if (quote_char == '"' && trimmed[i] == '\\' && i + 1 < trimmed.size()) {
-            char next = trimmed[i + 1];
-            switch (next) {
-            case 'n':
-                result += '\n';
-                break;
-            case 't':
-                result += '\t';
-                break;
-            case 'r':
-                result += '\r';
-                break;
-            case '\\':
-                result += '\\';
-                break;
-            case '"':
-                result += '"';
-                break;
-            default:
-                result += '\\';
-                result += next;
-                break;
+auto dotenv::detail::global_store() noexcept -> env_store & { return envStore; }
+
+auto dotenv::detail::parse_entries(std::string_view content, env_map &entries,
+                                   key_set *literal_keys, std::uint32_t source,
+                                   parse_stats *stats,
+                                   const load_options &options,
+                                   budget_meter *meter) -> int {
+    const auto store = [&](parsed_entry &&entry) {
+        if (literal_keys != nullptr) {
+            // A última definição da chave decide
+            if (entry.single_quoted) {
+                literal_keys->emplace(entry.key);
+            } else if (auto it = literal_keys->find(entry.key);
+                       it != literal_keys->end()) {
+                literal_keys->erase(it);
             }
-            ++i; // Pula o próximo caractere
-        } else {
-            result += trimmed[i];
         }
+        ValueStruct value(std::move(entry.value), true);
+        set_location(value, source, entry.line, entry.offset);
+        entries.insert_or_assign(std::string(entry.key), std::move(value));
+    };
+    const auto file =
+        options.on_diagnostic ? source_path(source) : std::string();
+    bool rejected = false;
+    const int count = parse_content(content, store, find_newline,
+                                    checked_reporter(options, file, rejected),
+                                    stats, options.limits, meter);
+    if (rejected) {
+        throw strict_violation();
     }
-
-    return result;
+    return count;
 }
 
-// Limites de segurança para evitar DoS
-static constexpr size_t MAX_LINE_LENGTH = 8192;
-static constexpr size_t MAX_KEY_LENGTH = 256;
-static constexpr size_t MAX_VALUE_LENGTH = 4096;
-
-// Threshold baseado em dados empíricos: SIMD só vale a pena para arquivos >50KB
-static constexpr size_t MIN_FILE_SIZE_FOR_SIMD =
-    static_cast<const size_t>(50U * 1024U);
+namespace {
+// Arquivos de origem das entradas; só cresce, então os ids não mudam
+std::mutex sourcesMutex;
+std::vector<std::string> sourcePaths;
+std::unordered_map<std::string, std::uint32_t, dotenv::detail::string_hash,
+                   std::equal_to<>>
+    sourceIds;
+} // namespace
 
-// Validação de chave (deve ser um identificador válido)
-static auto is_valid_key(std::string_view key) -> bool {
-    if (key.empty() || key.size() > MAX_KEY_LENGTH) {
-        return false;
+auto dotenv::detail::register_source(std::string_view path) -> std::uint32_t {
+    std::lock_guard lock(sourcesMutex);
+    if (auto it = sourceIds.find(path); it != sourceIds.end()) {
+        return it->second;
     }
+    sourcePaths.emplace_back(path);
+    const auto source = static_cast<std::uint32_t>(sourcePaths.size());
+    sourceIds.emplace(std::string(path), source);
+    return source;
+}
 
-    // Primeira char deve ser letra ou underscore
-    if ((std::isalpha(key[0]) == 0) && key[0] != '_') {
-        return false;
+auto dotenv::detail::source_path(std::uint32_t source) -> std::string {
+    std::lock_guard lock(sourcesMutex);
+    if (source == 0 || source > sourcePaths.size()) {
+        return {};
     }
+    return sourcePaths[source - 1];
+}
 
-    // Restante deve ser alfanumérico ou underscore
-    for (size_t i = 1; i < key.size(); ++i) {
-        if ((std::isalnum(key[i]) == 0) && key[i] != '_') {
-            return false;
-        }
+// Copia a entrada armazenada sob o lock do shard da chave
+static auto stored_entry(environment_state &env, std::string_view key)
+    -> std::optional<ValueStruct> {
+    return env.store.read(
+        key, [](const ValueStruct *entry) -> std::optional<ValueStruct> {
+            if (entry == nullptr) {
+                return std::nullopt;
+            }
+            return *entry;
+        });
+}
+
+static auto process_value(std::string_view name)
+    -> std::optional<std::string> {
+    std::string name_str(name);
+    auto *value = getenv(name_str.c_str());
+    if (value == nullptr) {
+        return std::nullopt;
     }
+    return std::string(value);
+}
 
-    return true;
+// process_value(), se `env` consulta o ambiente do processo
+static auto fallback_value(const environment_state &env, std::string_view name)
+    -> std::optional<std::string> {
+    if (!env.process_env) {
+        return std::nullopt;
+    }
+    return process_value(name);
 }
 
-// Declaração antecipada da implementação tradicional
-static auto
-load_traditional_implementation(std::string_view path, int replace,
-                                bool apply_system_env = true) noexcept -> int;
+// fn(const std::string *) com o valor adiado de `key` expandido pelo cache
+template <class Fn>
+static auto with_expanded(environment_state &env, std::string_view key,
+                          Fn &&fn) {
+    return env.expansions.with_value(
+        key, [&env](std::string_view name) { return stored_entry(env, name); },
+        [&env](std::string_view name) { return fallback_value(env, name); },
+        std::forward<Fn>(fn));
+}
 
-namespace {
+// Copia o valor armazenado, expandindo-o se for adiado
+static auto stored_value(environment_state &env, std::string_view key)
+    -> std::optional<std::string> {
+    auto entry = stored_entry(env, key);
+    if (!entry) {
+        return std::nullopt;
+    }
+    if (!entry->deferred) {
+        return std::move(entry->data);
+    }
+    return with_expanded(
+        env, key, [](const std::string *value) -> std::optional<std::string> {
+            if (value == nullptr) {
+                return std::nullopt;
+            }
+            return *value;
+        });
+}
 
-// Estrutura para armazenar valor e flag de gerenciamento
-struct ValueStruct {
-    std::string data;
-    bool managedKey{};
+auto dotenv::detail::pinned_value(const env_table &table, std::string_view key,
+                                  const ValueStruct &value)
+    -> const std::string & {
+    if (!value.deferred) {
+        return value.data;
+    }
 
-    ValueStruct() = default;
-    ValueStruct(std::string value, bool managed)
-        : data(std::move(value)), managedKey(managed) {}
-};
+    std::lock_guard lock(table.expanded_mutex);
+    if (auto it = table.expanded.find(key); it != table.expanded.end()) {
+        return it->second;
+    }
+    auto pinned_entry =
+        [&table](std::string_view name) -> std::optional<ValueStruct> {
+        const auto *entry = table.find(name);
+        if (entry == nullptr) {
+            return std::nullopt;
+        }
+        return *entry;
+    };
+    auto external = [&table](std::string_view name) {
+        return table.process_env ? process_value(name) : std::nullopt;
+    };
+    return dotenv::detail::expand_deferred(key, value.data, pinned_entry,
+                                           external, table.expanded);
+}
 
-// Mapa seguro que possui a memória das strings e sincronização para threads
-std::unordered_map<std::string, ValueStruct> envMap;
-std::mutex envMapMutex;
+// Fixa o store de `env`; as expansões do estado fixado seguem a consulta ao
+// ambiente do processo de `env`
+static auto pin_state(environment_state &env)
+    -> std::pair<std::shared_ptr<dotenv::detail::env_table>, std::uint64_t> {
+    auto pinned = env.store.pin();
+    pinned.first->process_env = env.process_env;
+    return pinned;
+}
 
-inline void processLine(std::string_view line, [[maybe_unused]] int replace,
-                        int &count) {
-    auto trimmed_line = trim(line);
+// Consulta externa da interpolação: store de `env`, depois ambiente do
+// processo
+static auto stored_or_process(environment_state &env, std::string_view name)
+    -> std::optional<std::string> {
+    if (auto stored = stored_value(env, name)) {
+        return stored;
+    }
+    return fallback_value(env, name);
+}
 
-    // Early returns para filtros
-    if (trimmed_line.empty() || trimmed_line[0] == '#') {
+// Interpolação sobre entradas já analisadas; nomes ausentes de `entries` vão
+// para `lookup`. Só a expansão eager consome o orçamento de `meter`.
+static void expand_entries(env_map &entries,
+                           const dotenv::detail::key_set &literal_keys,
+                           dotenv::interpolation expansion,
+                           const dotenv::detail::external_lookup &lookup,
+                           dotenv::detail::budget_meter *meter = nullptr) {
+    if (expansion == dotenv::interpolation::eager) {
+        dotenv::detail::interpolate_entries(entries, literal_keys, lookup,
+                                            meter);
         return;
     }
 
-    if (trimmed_line.size() > MAX_LINE_LENGTH) {
-        return;
+    // Adiada: guarda os templates; só auto-referências são resolvidas agora,
+    // enquanto o valor anterior ainda existe
+    for (auto &[key, value] : entries) {
+        if (literal_keys.contains(key) ||
+            !dotenv::detail::needs_expansion(value.data)) {
+            continue;
+        }
+        if (value.data.find(key) != std::string::npos) {
+            value.data = dotenv::detail::bind_self_references(key, value.data,
+                                                              lookup(key));
+        }
+        value.deferred = true;
     }
+}
+
+// detail::parse_source com as referências resolvidas no store de `env`
+static auto parse_into(environment_state &env, std::string_view content,
+                       const dotenv::load_options &options, env_map &entries,
+                       std::uint32_t source = 0,
+                       dotenv::detail::parse_stats *stats = nullptr) -> int {
+    std::optional<dotenv::detail::budget_meter> meter;
+    if (options.budget != dotenv::load_budget{}) {
+        meter.emplace(options.budget);
+    }
+    auto *budget = meter ? &*meter : nullptr;
+    if (options.expansion == dotenv::interpolation::none) {
+        return dotenv::detail::parse_entries(content, entries, nullptr, source,
+                                             stats, options, budget);
+    }
+
+    dotenv::detail::key_set literal_keys;
+    const int count = dotenv::detail::parse_entries(
+        content, entries, &literal_keys, source, stats, options, budget);
+    expand_entries(
+        entries, literal_keys, options.expansion,
+        [&env](std::string_view name) { return stored_or_process(env, name); },
+        budget);
+    return count;
+}
 
-    // Buscar primeiro '=' - parsing simplificado e correto
-    // Aspas só importam para o VALOR, não durante a busca do '='
-    size_t eq_pos = trimmed_line.find('=');
+auto dotenv::detail::parse_source(std::string_view content,
+                                  const load_options &options,
+                                  env_map &entries, std::uint32_t source,
+                                  parse_stats *stats) -> int {
+    return parse_into(defaultState, content, options, entries, source, stats);
+}
 
-    // Early return: sem separador '='
-    if (eq_pos == std::string_view::npos) {
-        return;
+// Grava `entries` no store de `env` em um único lote (os valores são
+// movidos) e invalida, fora dos locks, as expansões que liam essas chaves
+static void commit_entries(environment_state &env, env_map &entries,
+                           bool replace) {
+    if (std::any_of(entries.begin(), entries.end(),
+                    [](const auto &entry) { return entry.second.deferred; })) {
+        env.expansions.enable();
+    }
+    env.store.write_batch([&](dotenv::detail::env_store::batch &pending) {
+        for (auto &[key, value] : entries) {
+            auto &shard_entries = pending.entries_for(key);
+            if (replace) {
+                shard_entries.insert_or_assign(key, std::move(value));
+            } else {
+                shard_entries.emplace(key, std::move(value));
+            }
+        }
+    });
+    for (const auto &entry : entries) {
+        env.expansions.invalidate(entry.first);
     }
+}
 
-    auto raw_key = trim(trimmed_line.substr(0, eq_pos));
-
-    // Early return: chave inválida
-    if (!is_valid_key(raw_key)) {
-        return;
+// Esvazia `env`; com `clear_system`, também remove do ambiente do processo
+// as chaves gerenciadas
+static void clear_state(environment_state &env, bool clear_system) {
+    // O store não corresponde mais aos arquivos carregados
+    {
+        std::lock_guard lock(env.tracked_mutex);
+        env.tracked.clear();
     }
 
-    auto raw_value = trimmed_line.substr(eq_pos + 1);
-    auto processed_value = process_quoted_value(raw_value);
+    // Snapshots mantêm as tabelas anteriores vivas
+    env.store.clear([clear_system](const std::string &key,
+                                   const ValueStruct &value) {
+        if (clear_system && value.managedKey) {
+            unset_env(key.c_str());
+        }
+    });
+    env.expansions.clear();
+}
+
+// Copia todo o store de `env` para o ambiente do processo
+static void apply_to_process(environment_state &env,
+                             dotenv::overwrite overwrite_policy) {
+    int replace_flag = (overwrite_policy == dotenv::overwrite::replace) ? 1 : 0;
+    auto [table, generation] = env.store.pin();
+    table->for_each([&](const std::string &key, const ValueStruct &value) {
+        set_env(key.c_str(), pinned_value(*table, key, value).c_str(),
+                replace_flag);
+    });
+}
 
-    // Early return: valor muito longo
-    if (processed_value.size() > MAX_VALUE_LENGTH) {
-        processed_value.resize(MAX_VALUE_LENGTH);
+// Aplica ao ambiente do processo só as chaves de `entries`, recém gravadas
+// em `env`, lidas de um único estado fixado
+static void apply_loaded_keys(environment_state &env, const env_map &entries,
+                              const dotenv::load_options &options) {
+    if (!env.process_env ||
+        options.apply_to_process != dotenv::process_env_apply::yes) {
+        return;
     }
 
-    std::lock_guard<std::mutex> lock(envMapMutex);
-    std::string key_str(raw_key);
-    count++;
-    if (replace != 0) {
-        envMap.insert_or_assign(std::move(key_str),
-                                ValueStruct(std::move(processed_value), true));
-    } else {
-        // Se replace=false, só insere se não existir
-        envMap.emplace(std::move(key_str),
-                       ValueStruct(std::move(processed_value), true));
+    const int replace_flag =
+        (options.overwrite_policy == dotenv::overwrite::replace) ? 1 : 0;
+    auto [table, generation] = env.store.pin();
+    for (const auto &entry : entries) {
+        if (const auto *value = table->find(entry.first)) {
+            set_env(entry.first.c_str(),
+                    pinned_value(*table, entry.first, *value).c_str(),
+                    replace_flag);
+        }
     }
 }
 
-} // namespace
+// Converte as opções da API C para a C++; limites 0 mantêm o padrão
+static auto c_load_options(const dotenv_load_options_t &options)
+    -> dotenv::load_options {
+    dotenv::load_options converted{
+        .overwrite_policy = (options.replace_existing != 0)
+                                ? dotenv::overwrite::replace
+                                : dotenv::overwrite::preserve,
+        .apply_to_process = (options.apply_to_system != 0)
+                                ? dotenv::process_env_apply::yes
+                                : dotenv::process_env_apply::no};
+    auto &limits = converted.limits;
+    if (options.max_line_length != 0) {
+        limits.max_line_length = options.max_line_length;
+    }
+    if (options.max_key_length != 0) {
+        limits.max_key_length = options.max_key_length;
+    }
+    if (options.max_value_length != 0) {
+        limits.max_value_length = options.max_value_length;
+    }
+    return converted;
+}
+
+static void fill_stats(const dotenv::load_report &report,
+                       dotenv_load_stats_t &stats) {
+    stats.variables_loaded = report.variables_loaded;
+    stats.variables_skipped = report.lines_skipped;
+    stats.variables_rejected = report.lines_rejected + report.lines_too_long;
+    stats.lines_processed = report.lines_processed;
+}
 
 extern "C" {
 /* Helper function to parse boolean values */
@@ -379,6 +682,21 @@ auto dotenv_load(const char *path, int replace, int apply_system_env) -> int {
     return dotenv::load_raw(file_path, replace, apply_system_env != 0);
 }
 
+auto dotenv_load_if_changed(const char *path, int replace,
+                            int apply_system_env) -> int {
+    const char *file_path = (path != nullptr) ? path : ".env";
+    auto [error, count] = dotenv::load_legacy(
+        file_path,
+        {.overwrite_policy = (replace != 0) ? dotenv::overwrite::replace
+                                            : dotenv::overwrite::preserve,
+         .apply_to_process = (apply_system_env != 0)
+                                 ? dotenv::process_env_apply::yes
+                                 : dotenv::process_env_apply::no,
+         .skip_if_unchanged = true});
+    return (error == dotenv::dotenv_error::success) ? count
+                                                    : static_cast<int>(error);
+}
+
 auto dotenv_load_ex(const char *path, const dotenv_load_options_t *options,
                     dotenv_load_stats_t *stats) -> dotenv_error_t {
     if (path == nullptr) {
@@ -398,24 +716,62 @@ auto dotenv_load_ex(const char *path, const dotenv_load_options_t *options,
     }
 
     try {
-        int result = dotenv::load_raw(path, options->replace_existing,
-                                      options->apply_to_system != 0);
-
-        if (result < 0) {
-            return static_cast<dotenv_error_t>(result);
+        if (stats == nullptr) {
+            return static_cast<dotenv_error_t>(
+                dotenv::load_legacy(path, c_load_options(*options)).first);
         }
 
-        if (stats != nullptr) {
-            stats->variables_loaded = result;
-            // Additional stats would need implementation in the core library
+        // Contadores só existem no caminho em etapas do parser
+        auto [error, report] = dotenv::load_with_report(
+            path, c_load_options(*options));
+        if (error != dotenv::dotenv_error::success) {
+            return static_cast<dotenv_error_t>(error);
         }
-
+        fill_stats(report, *stats);
         return DOTENV_SUCCESS;
     } catch (const std::exception &) {
         return DOTENV_ERROR_INVALID_FORMAT;
     }
 }
 
+auto dotenv_load_report(const char *path, const dotenv_load_options_t *options,
+                        dotenv_load_report_t *report) -> dotenv_error_t {
+    if (report == nullptr ||
+        report->struct_size < offsetof(dotenv_load_report_t, stats)) {
+        return DOTENV_ERROR_INVALID_ARGUMENT;
+    }
+    if (path == nullptr) {
+        path = ".env";
+    }
+
+    dotenv_load_options_t default_opts;
+    if (options == nullptr) {
+        dotenv_get_default_options(&default_opts);
+        options = &default_opts;
+    }
+
+    auto [error, cpp_report] =
+        dotenv::load_with_report(path, c_load_options(*options));
+
+    // Copia só o prefixo que o chamador conhece (struct_size)
+    dotenv_load_report_t full{};
+    full.struct_size = static_cast<unsigned>(sizeof(full));
+    full.version = DOTENV_LOAD_REPORT_VERSION;
+    fill_stats(cpp_report, full.stats);
+    full.lines_too_long = cpp_report.lines_too_long;
+    full.values_truncated = cpp_report.values_truncated;
+    full.open_ns = static_cast<uint64_t>(cpp_report.open.count());
+    full.parse_ns = static_cast<uint64_t>(cpp_report.parse.count());
+    full.commit_ns = static_cast<uint64_t>(cpp_report.commit.count());
+    full.apply_ns = static_cast<uint64_t>(cpp_report.apply.count());
+    full.total_ns = static_cast<uint64_t>(cpp_report.total.count());
+    const size_t size = std::min<size_t>(report->struct_size, sizeof(full));
+    std::memcpy(report, &full, size);
+    report->struct_size = static_cast<unsigned>(size);
+
+    return static_cast<dotenv_error_t>(error);
+}
+
 auto dotenv_load_traditional(const char *path, int replace,
                              int apply_system_env) -> int {
     const char *file_path = (path != nullptr) ? path : ".env";
@@ -429,13 +785,23 @@ auto dotenv_get(const char *key, const char *default_value) -> const char * {
         return (default_value != nullptr) ? default_value : "";
     }
 
-    std::lock_guard<std::mutex> lock(envMapMutex);
-
-    std::string key_str(key);
-    auto it = envMap.find(key_str);
-
-    if (it != envMap.end()) {
-        return it->second.data.c_str();
+    bool deferred = false;
+    const char *stored = envStore.read(
+        key, [&deferred](const ValueStruct *entry) -> const char * {
+            if (entry == nullptr) {
+                return nullptr;
+            }
+            deferred = entry->deferred;
+            return entry->data.c_str();
+        });
+    if (deferred) {
+        stored = with_expanded(
+            defaultState, key, [](const std::string *value) {
+                return (value != nullptr) ? value->c_str() : nullptr;
+            });
+    }
+    if (stored != nullptr) {
+        return stored;
     }
 
     auto *value = getenv(key);
@@ -444,6 +810,35 @@ auto dotenv_get(const char *key, const char *default_value) -> const char * {
                : ((default_value != nullptr) ? default_value : "");
 }
 
+/* Snapshot functions */
+struct dotenv_snapshot {
+    dotenv::snapshot pinned;
+};
+
+auto dotenv_snapshot_acquire() -> dotenv_snapshot_t * {
+    try {
+        return std::make_unique<dotenv_snapshot>().release();
+    } catch (const std::exception &) {
+        return nullptr;
+    }
+}
+
+auto dotenv_snapshot_get(const dotenv_snapshot_t *snapshot, const char *key,
+                         const char *default_value) -> const char * {
+    const char *fallback = (default_value != nullptr) ? default_value : "";
+    if ((snapshot == nullptr) || (key == nullptr)) {
+        return fallback;
+    }
+
+    // Valores vêm de std::string, portanto a view é terminada em '\0'
+    auto value = snapshot->pinned.find(key);
+    return value ? value->data() : fallback;
+}
+
+void dotenv_snapshot_release(dotenv_snapshot_t *snapshot) {
+    std::unique_ptr<dotenv_snapshot> owner(snapshot);
+}
+
 auto dotenv_get_buffer(const char *key, char *buffer, size_t buffer_size)
     -> dotenv_error_t {
     if ((key == nullptr) || (buffer == nullptr) || buffer_size == 0) {
@@ -584,6 +979,10 @@ void dotenv_get_default_options(dotenv_load_options_t *options) {
 }
 
 auto dotenv_get_error_message(dotenv_error_t error_code) -> const char * {
+    // Fora da enumeração de dotenv_errors.h
+    if (error_code == DOTENV_ERROR_LIMIT_EXCEEDED) {
+        return "Limit exceeded";
+    }
     switch (error_code) {
     case DOTENV_SUCCESS:
         return "Success";
@@ -620,65 +1019,81 @@ auto dotenv_get_version(int *major, int *minor, int *patch) -> const char * {
     return version;
 }
 
+// Entradas do estado fixado com a chave começando em `prefix`, ordenadas
+static auto prefixed_entries(const dotenv::detail::env_table &table,
+                             std::string_view prefix)
+    -> std::vector<std::pair<const std::string *, const ValueStruct *>> {
+    std::vector<std::pair<const std::string *, const ValueStruct *>> found;
+    table.for_each_with_prefix(
+        prefix, [&found](const std::string &key, const ValueStruct &value) {
+            found.emplace_back(&key, &value);
+        });
+    std::sort(found.begin(), found.end(), [](const auto &lhs, const auto &rhs) {
+        return *lhs.first < *rhs.first;
+    });
+    return found;
+}
+
 /* Advanced functions */
 auto dotenv_enumerate(dotenv_iterator_t iterator, void *user_data) -> int {
     if (iterator == nullptr) {
         return DOTENV_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(envMapMutex);
-
-    int count = 0;
-    for (const auto &[key, value] : envMap) {
-        if (iterator(key.c_str(), value.data.c_str(), user_data) != 0) {
-            break; // Iterator requested stop
-        }
-        count++;
-    }
+    // Estado fixado: valores adiados são expandidos sem locks do store
+    auto [table, generation] = envStore.pin();
+    auto count = table->for_each_until(
+        [&](const std::string &key, const ValueStruct &value) {
+            // Iterator requests stop with a non-zero return
+            const auto &data = pinned_value(*table, key, value);
+            return iterator(key.c_str(), data.c_str(), user_data) == 0;
+        });
 
-    return count;
+    return static_cast<int>(count);
 }
 
-auto dotenv_clear(int clear_system) -> dotenv_error_t {
-    std::lock_guard<std::mutex> lock(envMapMutex);
+auto dotenv_enumerate_prefix(const char *prefix, dotenv_iterator_t iterator,
+                             void *user_data) -> int {
+    if (prefix == nullptr || iterator == nullptr) {
+        return DOTENV_ERROR_INVALID_ARGUMENT;
+    }
 
-    if (clear_system != 0) {
-        // Clear from system environment
-        for (const auto &[key, value] : envMap) {
-            if (value.managedKey) {
-#ifdef _WIN32
-                std::string env_str = key + "=";
-                _putenv(env_str.c_str());
-#else
-                unsetenv(key.c_str());
-#endif
+    try {
+        auto [table, generation] = envStore.pin();
+        int count = 0;
+        for (const auto &[key, value] : prefixed_entries(*table, prefix)) {
+            const auto &data = pinned_value(*table, *key, *value);
+            if (iterator(key->c_str(), data.c_str(), user_data) != 0) {
+                break;
             }
+            ++count;
         }
+        return count;
+    } catch (const std::exception &) {
+        return DOTENV_ERROR_OUT_OF_MEMORY;
     }
+}
 
-    // Clear internal storage
-    envMap.clear();
-
+auto dotenv_clear(int clear_system) -> dotenv_error_t {
+    clear_state(defaultState, clear_system != 0);
     return DOTENV_SUCCESS;
 }
 }
 
 void dotenv::apply_internal_to_process_env(overwrite overwrite_policy) {
-    std::lock_guard<std::mutex> lock(envMapMutex);
-    int replace_flag = (overwrite_policy == overwrite::replace) ? 1 : 0;
-    for (const auto &pair : envMap) {
-        set_env(pair.first.c_str(), pair.second.data.c_str(), replace_flag);
-    }
+    apply_to_process(defaultState, overwrite_policy);
 }
 
-auto dotenv::load_raw(std::string_view path, int replace,
-                      bool apply_system_env) noexcept -> int {
+// Seleção automática de backend entre tradicional e SIMD
+static auto load_auto_detect(environment_state &env, std::string_view path,
+                             const dotenv::load_options &options) noexcept
+    -> int {
 #ifdef DOTENV_SIMD_ENABLED
     // Auto-detecção inteligente: usar SIMD sempre que disponível
 
     // Early return: verificar se AVX2 está disponível
-    if (!simd::is_avx2_available()) {
-        return load_traditional_implementation(path, replace, apply_system_env);
+    if (!dotenv::simd::is_avx2_available()) {
+        return load_traditional_implementation(env, path, options);
     }
 
     // Lambda para verificação de arquivo e otimização SIMD
@@ -698,16 +1113,10 @@ auto dotenv::load_raw(std::string_view path, int replace,
             return std::nullopt; // Usar implementação tradicional
         }
 
-        // Use the legacy pair-returning SIMD API
-        auto [simd_error, simd_count] = load_simd_legacy(
-            path, {.overwrite_policy = (replace != 0) ? overwrite::replace
-                                                      : overwrite::preserve,
-                   .apply_to_process = apply_system_env ? process_env_apply::yes
-                                                        : process_env_apply::no,
-                   .backend = parse_backend::simd});
-
-        if (simd_error == dotenv_error::success) {
-            return simd_count;
+        // Com strict o backend tradicional rejeitaria as mesmas linhas
+        const int result = load_simd_implementation(env, path, options);
+        if (result >= 0 || result == -3) {
+            return result;
         }
         return std::nullopt;
     };
@@ -719,13 +1128,20 @@ auto dotenv::load_raw(std::string_view path, int replace,
 #endif
 
     // Fallback: implementação tradicional
-    return load_traditional_implementation(path, replace, apply_system_env);
+    return load_traditional_implementation(env, path, options);
+}
+
+auto dotenv::load_raw(std::string_view path, int replace,
+                      bool apply_system_env) noexcept -> int {
+    return load_auto_detect(defaultState, path,
+                            raw_options(replace, apply_system_env));
 }
 
 // Função pública para forçar implementação tradicional (benchmarking)
 auto dotenv::load_traditional_raw(std::string_view path, int replace,
                                   bool apply_system_env) noexcept -> int {
-    return load_traditional_implementation(path, replace, apply_system_env);
+    return load_traditional_implementation(
+        defaultState, path, raw_options(replace, apply_system_env));
 }
 
 auto dotenv::load_with_status(std::string_view path, int replace,
@@ -780,62 +1196,124 @@ auto dotenv::load_traditional_with_status(std::string_view path, int replace,
     return {DOTENV_SUCCESS, result};
 }
 
-// Implementação tradicional extraída para reutilização
-static auto load_traditional_implementation(std::string_view path, int replace,
-                                            bool apply_system_env) noexcept
+// Carga com o parser compartilhado; os backends diferem só na busca de fim
+// de linha. O arquivo inteiro é preparado em um mapa privado e gravado em um
+// único lote: uma falha no meio (ou, com strict, uma linha inválida, -3) não
+// deixa nada no store nem no ambiente do processo. Linhas rejeitadas só são
+// relatadas com sink.
+static auto load_with_parser(environment_state &env, std::string_view path,
+                             const dotenv::load_options &options,
+                             dotenv::detail::newline_finder next_newline)
     -> int {
-
-    // Implementação padrão (fallback ou para arquivos pequenos)
-    std::ifstream dotenv((std::filesystem::path(path)));
-
-    if (!dotenv.is_open()) {
-        return -1;
+    dotenv::mapped_file file;
+    if (int error = map_source(std::string(path), file,
+                               options.limits.max_file_size);
+        error != 0) {
+        return error;
+    }
+
+    const bool replace =
+        (options.overwrite_policy == dotenv::overwrite::replace);
+    const auto source = dotenv::detail::register_source(path);
+    env_map staged;
+    bool rejected = false;
+    const int count = dotenv::detail::parse_content(
+        file.view(),
+        [&staged, replace, source](dotenv::detail::parsed_entry &&entry) {
+            ValueStruct value(std::move(entry.value), true);
+            dotenv::detail::set_location(value, source, entry.line,
+                                         entry.offset);
+            std::string key(entry.key);
+            // Com preserve, a primeira definição do arquivo vence
+            if (replace) {
+                staged.insert_or_assign(std::move(key), std::move(value));
+            } else {
+                staged.emplace(std::move(key), std::move(value));
+            }
+        },
+        next_newline, checked_reporter(options, path, rejected), nullptr,
+        options.limits);
+    file.close();
+    if (rejected) {
+        return -3;
     }
-    int count = 0;
-
-    size_t line_number = 0;
 
-    std::string line;
-    while (std::getline(dotenv, line)) {
-        ++line_number;
-
-        // Verificação de limite de linha para evitar DoS
-        if (line.size() > MAX_LINE_LENGTH) {
-            std::cerr << "Warning: Line " << line_number
-                      << " exceeds maximum length (" << MAX_LINE_LENGTH
-                      << " chars), skipping" << '\n';
-            continue;
-        }
+    commit_entries(env, staged, replace);
+    apply_loaded_keys(env, staged, options);
+    return count;
+}
 
-        processLine(line, replace, count);
+// Implementação tradicional extraída para reutilização
+static auto
+load_traditional_implementation(environment_state &env, std::string_view path,
+                                const dotenv::load_options &options) noexcept
+    -> int {
+    try {
+        return load_with_parser(env, path, options,
+                                dotenv::detail::find_newline);
+    } catch (const std::exception &) {
+        return -4;
     }
+}
 
-    dotenv.close();
-
-    if (apply_system_env) {
-        dotenv::apply_internal_to_process_env(
-            (replace != 0) ? dotenv::overwrite::replace
-                           : dotenv::overwrite::preserve);
+#ifdef DOTENV_SIMD_ENABLED
+// Mesmo parser do backend tradicional; só a busca de fim de linha usa AVX2
+static auto
+load_simd_implementation(environment_state &env, std::string_view path,
+                         const dotenv::load_options &options) noexcept -> int {
+    if (!dotenv::simd::is_avx2_available()) {
+        return load_traditional_implementation(env, path, options);
+    }
+    try {
+        return load_with_parser(env, path, options,
+                                dotenv::simd::find_newline_avx2);
+    } catch (const std::exception &) {
+        return -4;
     }
-
-    return count;
 }
+#endif
 
-auto dotenv::get(std::string_view key, std::string_view default_value)
+auto dotenv::environment::get(std::string_view key,
+                              std::string_view default_value) const
     -> std::string_view {
-    std::lock_guard<std::mutex> lock(envMapMutex);
-
-    std::string key_str(key);
-    auto it = envMap.find(key_str);
-
-    if (it != envMap.end()) {
-        return it->second.data;
+    bool deferred = false;
+    auto stored = state_->store.read(
+        key,
+        [&deferred](
+            const ValueStruct *entry) -> std::optional<std::string_view> {
+            if (entry == nullptr) {
+                return std::nullopt;
+            }
+            deferred = entry->deferred;
+            return entry->data;
+        });
+    if (deferred) {
+        stored = with_expanded(
+            *state_, key,
+            [](const std::string *value) -> std::optional<std::string_view> {
+                if (value == nullptr) {
+                    return std::nullopt;
+                }
+                return *value;
+            });
+    }
+    if (stored) {
+        return *stored;
+    }
+    if (!state_->process_env) {
+        return default_value;
     }
 
+    std::string key_str(key);
     auto *value = getenv(key_str.c_str());
     return (value != nullptr) ? value : default_value;
 }
 
+auto dotenv::get(std::string_view key, std::string_view default_value)
+    -> std::string_view {
+    return default_environment().get(key, default_value);
+}
+
 // ===== CORE C++20 API IMPLEMENTATIONS =====
 
 // Helper function to convert legacy int error codes to dotenv_error
@@ -854,78 +1332,272 @@ static auto convert_error_code(int error_code) noexcept
         return dotenv::dotenv_error::out_of_memory;
     case -5:
         return dotenv::dotenv_error::invalid_argument;
+    case -8:
+        return dotenv::dotenv_error::limit_exceeded;
     default:
         return dotenv::dotenv_error::invalid_format;
     }
 }
 
-// Primary C++20 load API (renamed to legacy pair-returning)
-auto dotenv::load_legacy(std::string_view path,
-                         const load_options &options) noexcept
-    -> std::pair<dotenv::dotenv_error, int> {
-    try {
-        int replace_flag =
-            (options.overwrite_policy == overwrite::replace) ? 1 : 0;
-        bool apply_to_env =
-            (options.apply_to_process == process_env_apply::yes);
+// Registro compatível com as políticas pedidas; requer env.tracked_mutex
+static auto tracked_entry(environment_state &env, const std::string &path,
+                          const dotenv::load_options &options)
+    -> environment_state::tracked_file * {
+    auto it = env.tracked.find(path);
+    if (it == env.tracked.end() ||
+        it->second.replace !=
+            (options.overwrite_policy == dotenv::overwrite::replace) ||
+        it->second.apply_system_env !=
+            (options.apply_to_process == dotenv::process_env_apply::yes) ||
+        it->second.expansion != options.expansion ||
+        it->second.limits != options.limits ||
+        it->second.budget != options.budget ||
+        it->second.strict != options.strict) {
+        return nullptr;
+    }
+    return &it->second;
+}
 
-        int result = 0;
-        switch (options.backend) {
-        case parse_backend::auto_detect:
-            result = load_raw(path, replace_flag, apply_to_env);
-            break;
-        case parse_backend::traditional:
-            result = load_traditional_raw(path, replace_flag, apply_to_env);
-            break;
-#ifdef DOTENV_SIMD_ENABLED
-        case parse_backend::simd: {
-            auto [simd_error, simd_count] = load_simd_legacy(
-                path,
-                {.overwrite_policy = (replace_flag == 1) ? overwrite::replace
-                                                         : overwrite::preserve,
-                 .apply_to_process = apply_to_env ? process_env_apply::yes
-                                                  : process_env_apply::no,
-                 .backend = parse_backend::simd});
-
-            if (simd_error == dotenv::dotenv_error::success) {
-                result = simd_count;
-            } else {
-                result = load_traditional_raw(path, replace_flag, apply_to_env);
-            }
-        } break;
-#else
-        case parse_backend::simd:
-            result = load_traditional_raw(path, replace_flag, apply_to_env);
-            break;
-#endif
+// Com skip_if_unchanged, retorna a contagem da última carga rastreada em
+// `env` se o arquivo não mudou. Caso contrário preenche `fingerprint`
+// (tirada antes da leitura: uma mudança durante a carga só causa uma recarga
+// extra na próxima chamada, nunca um skip indevido) para remember_load.
+static auto unchanged_count(environment_state &env, std::string_view path,
+                            const dotenv::load_options &options,
+                            dotenv::detail::file_fingerprint &fingerprint)
+    -> std::optional<int> {
+    if (!options.skip_if_unchanged) {
+        return std::nullopt;
+    }
+
+    std::string path_str(path);
+
+    if (!dotenv::detail::read_fingerprint(path_str, fingerprint)) {
+        return std::nullopt;
+    }
+
+    {
+        std::lock_guard lock(env.tracked_mutex);
+        const auto *previous = tracked_entry(env, path_str, options);
+        if (previous != nullptr &&
+            previous->fingerprint.same_metadata(fingerprint)) {
+            return previous->count;
         }
+    }
 
-        if (result < 0) {
-            return {convert_error_code(result), 0};
+    // Metadados mudaram (ou mtime recente demais): decide pelo conteúdo
+    {
+        dotenv::mapped_file file;
+        if (!file.map(path_str)) {
+            return std::nullopt;
         }
+        fingerprint.content_hash = dotenv::detail::content_hash(file.view());
+    }
 
-        return {dotenv::dotenv_error::success, result};
-    } catch (const std::exception &) {
-        return {dotenv::dotenv_error::out_of_memory, 0};
+    std::lock_guard lock(env.tracked_mutex);
+    auto *previous = tracked_entry(env, path_str, options);
+    if (previous != nullptr &&
+        previous->fingerprint.content_hash == fingerprint.content_hash) {
+        previous->fingerprint = fingerprint;
+        return previous->count;
     }
+    return std::nullopt;
 }
 
-// Traditional backend (C++20 API)
-auto dotenv::load_traditional_legacy(std::string_view path,
+// Registra uma carga bem-sucedida feita com skip_if_unchanged
+static void remember_load(environment_state &env, std::string_view path,
+                          const dotenv::load_options &options,
+                          const dotenv::detail::file_fingerprint &fingerprint,
+                          int count) {
+    if (!options.skip_if_unchanged) {
+        return;
+    }
+
+    std::lock_guard lock(env.tracked_mutex);
+    env.tracked.insert_or_assign(
+        std::string(path),
+        environment_state::tracked_file{
+            fingerprint, count,
+            options.overwrite_policy == dotenv::overwrite::replace,
+            options.apply_to_process == dotenv::process_env_apply::yes,
+            options.expansion, options.limits, options.budget,
+            options.strict});
+}
+
+// Cargas que precisam do arquivo inteiro antes do commit: interpolação e
+// orçamento (esgotado no meio, nada pode ter chegado ao store)
+static auto needs_staging(const dotenv::load_options &options) noexcept
+    -> bool {
+    return options.expansion != dotenv::interpolation::none ||
+           options.budget != dotenv::load_budget{};
+}
+
+// Carga em etapas: o arquivo inteiro é preparado (e expandido, se pedido)
+// antes de chegar ao store, em um único lote. Ambos os backends usam o mesmo
+// parser. Com `report`, cada etapa é cronometrada e o parser conta as linhas.
+// Orçamento esgotado retorna -8 e linha inválida com strict, -3, sem commit.
+static auto load_staged(environment_state &env, std::string_view path,
+                        const dotenv::load_options &options,
+                        dotenv::load_report *report = nullptr) -> int {
+    using clock = std::chrono::steady_clock;
+    const auto started = clock::now();
+    dotenv::mapped_file file;
+    if (int error = map_source(std::string(path), file,
+                               options.limits.max_file_size);
+        error != 0) {
+        if (report != nullptr) {
+            report->open = report->total = clock::now() - started;
+        }
+        return error;
+    }
+    const auto opened = clock::now();
+
+    env_map entries;
+    dotenv::detail::parse_stats stats;
+    int count = 0;
+    int error = 0;
+    try {
+        count = parse_into(env, file.view(), options, entries,
+                           dotenv::detail::register_source(path),
+                           (report != nullptr) ? &stats : nullptr);
+    } catch (const dotenv::detail::budget_exceeded &) {
+        error = -8;
+    } catch (const dotenv::detail::strict_violation &) {
+        error = -3;
+    }
+    if (error != 0) {
+        if (report != nullptr) {
+            const auto stopped = clock::now();
+            report->open = opened - started;
+            report->parse = stopped - opened;
+            report->total = stopped - started;
+        }
+        return error;
+    }
+    file.close();
+    const auto parsed = clock::now();
+
+    commit_entries(env, entries,
+                   options.overwrite_policy == dotenv::overwrite::replace);
+    const auto committed = clock::now();
+
+    apply_loaded_keys(env, entries, options);
+
+    if (report != nullptr) {
+        const auto applied = clock::now();
+        report->variables_loaded = count;
+        report->lines_processed = static_cast<int>(stats.lines);
+        report->lines_skipped = static_cast<int>(stats.skipped);
+        report->lines_rejected = static_cast<int>(stats.rejected);
+        report->lines_too_long = static_cast<int>(stats.long_lines);
+        report->values_truncated = static_cast<int>(stats.truncated_values);
+        report->open = opened - started;
+        report->parse = parsed - opened;
+        report->commit = committed - parsed;
+        report->apply = applied - committed;
+        report->total = applied - started;
+    }
+    return count;
+}
+
+// Carga de `path` em `env` com o backend e as opções pedidos
+static auto load_into(environment_state &env, std::string_view path,
+                      const dotenv::load_options &options) noexcept
+    -> std::pair<dotenv::dotenv_error, int> {
+    try {
+        dotenv::detail::file_fingerprint fingerprint;
+        if (auto previous = unchanged_count(env, path, options, fingerprint)) {
+            return {dotenv::dotenv_error::success, *previous};
+        }
+
+        if (needs_staging(options)) {
+            int result = load_staged(env, path, options);
+            if (result < 0) {
+                return {convert_error_code(result), 0};
+            }
+            remember_load(env, path, options, fingerprint, result);
+            return {dotenv::dotenv_error::success, result};
+        }
+
+        int result = 0;
+        switch (options.backend) {
+        case dotenv::parse_backend::auto_detect:
+            result = load_auto_detect(env, path, options);
+            break;
+        case dotenv::parse_backend::traditional:
+            result = load_traditional_implementation(env, path, options);
+            break;
+#ifdef DOTENV_SIMD_ENABLED
+        case dotenv::parse_backend::simd:
+            // Com strict o backend tradicional rejeitaria as mesmas linhas
+            result = load_simd_implementation(env, path, options);
+            if (result < 0 && result != -3) {
+                result = load_traditional_implementation(env, path, options);
+            }
+            break;
+#else
+        case dotenv::parse_backend::simd:
+            result = load_traditional_implementation(env, path, options);
+            break;
+#endif
+        }
+
+        if (result < 0) {
+            return {convert_error_code(result), 0};
+        }
+
+        remember_load(env, path, options, fingerprint, result);
+        return {dotenv::dotenv_error::success, result};
+    } catch (const std::exception &) {
+        return {dotenv::dotenv_error::out_of_memory, 0};
+    }
+}
+
+// Primary C++20 load API (renamed to legacy pair-returning)
+auto dotenv::load_legacy(std::string_view path,
+                         const load_options &options) noexcept
+    -> std::pair<dotenv::dotenv_error, int> {
+    return default_environment().load(path, options);
+}
+
+auto dotenv::load_with_report(std::string_view path,
+                              const load_options &options) noexcept
+    -> std::pair<dotenv::dotenv_error, load_report> {
+    load_report report;
+    try {
+        int result = load_staged(defaultState, path, options, &report);
+        if (result < 0) {
+            return {convert_error_code(result), report};
+        }
+        return {dotenv::dotenv_error::success, report};
+    } catch (const std::exception &) {
+        return {dotenv::dotenv_error::out_of_memory, load_report{}};
+    }
+}
+
+// Traditional backend (C++20 API)
+auto dotenv::load_traditional_legacy(std::string_view path,
                                      const load_options &options) noexcept
     -> std::pair<dotenv::dotenv_error, int> {
     try {
-        int replace_flag =
-            (options.overwrite_policy == overwrite::replace) ? 1 : 0;
-        bool apply_to_env =
-            (options.apply_to_process == process_env_apply::yes);
+        if (needs_staging(options)) {
+            return load_legacy(path, options);
+        }
+
+        detail::file_fingerprint fingerprint;
+        if (auto previous =
+                unchanged_count(defaultState, path, options, fingerprint)) {
+            return {dotenv::dotenv_error::success, *previous};
+        }
 
-        int result = load_traditional_raw(path, replace_flag, apply_to_env);
+        int result = load_traditional_implementation(defaultState, path,
+                                                     options);
 
         if (result < 0) {
             return {convert_error_code(result), 0};
         }
 
+        remember_load(defaultState, path, options, fingerprint, result);
         return {dotenv::dotenv_error::success, result};
     } catch (const std::exception &) {
         return {dotenv::dotenv_error::out_of_memory, 0};
@@ -938,24 +1610,23 @@ auto dotenv::load_simd_legacy(std::string_view path,
                               const load_options &options) noexcept
     -> std::pair<dotenv::dotenv_error, int> {
     try {
-        int replace_flag =
-            (options.overwrite_policy == overwrite::replace) ? 1 : 0;
-        bool apply_to_env =
-            (options.apply_to_process == process_env_apply::yes);
+        if (needs_staging(options)) {
+            return load_legacy(path, options);
+        }
 
-        int result = 0;
-        if (simd::is_avx2_available()) {
-            // Use traditional implementation for now - SIMD implementation
-            // needs to be updated
-            result = load_traditional_raw(path, replace_flag, apply_to_env);
-        } else {
-            result = load_traditional_raw(path, replace_flag, apply_to_env);
+        detail::file_fingerprint fingerprint;
+        if (auto previous =
+                unchanged_count(defaultState, path, options, fingerprint)) {
+            return {dotenv::dotenv_error::success, *previous};
         }
 
+        int result = load_simd_implementation(defaultState, path, options);
+
         if (result < 0) {
             return {convert_error_code(result), 0};
         }
 
+        remember_load(defaultState, path, options, fingerprint, result);
         return {dotenv::dotenv_error::success, result};
     } catch (const std::exception &) {
         return {dotenv::dotenv_error::out_of_memory, 0};
@@ -963,6 +1634,35 @@ auto dotenv::load_simd_legacy(std::string_view path,
 }
 #endif
 
+// ===== ISOLATED ENVIRONMENTS =====
+
+dotenv::environment::environment()
+    : environment(process_env_fallback::yes) {}
+
+dotenv::environment::environment(process_env_fallback fallback)
+    : owned_(std::make_unique<detail::environment_state>()),
+      state_(owned_.get()) {
+    state_->process_env = (fallback == process_env_fallback::yes);
+}
+
+dotenv::environment::environment(detail::environment_state &shared) noexcept
+    : state_(&shared) {}
+
+dotenv::environment::~environment() = default;
+
+auto dotenv::default_environment() noexcept -> environment & {
+    static environment instance(defaultState);
+    return instance;
+}
+
+auto dotenv::environment::load(std::string_view path,
+                               const load_options &options) noexcept
+    -> std::pair<dotenv_error, int> {
+    return load_into(*state_, path, options);
+}
+
+void dotenv::environment::clear() { clear_state(*state_, false); }
+
 // ===== C++23 ENHANCED API IMPLEMENTATIONS =====
 
 #if DOTENV_HAS_STD_EXPECTED
@@ -1014,83 +1714,198 @@ int dotenv::load_traditional(std::string_view path, int replace,
 
 // ===== VARIABLE ACCESS API IMPLEMENTATIONS =====
 
-auto dotenv::value(std::string_view key, std::string_view default_value)
+auto dotenv::environment::value(std::string_view key,
+                                std::string_view default_value) const
     -> std::string {
-    std::lock_guard<std::mutex> lock(envMapMutex);
-
-    std::string key_str(key);
-    auto it = envMap.find(key_str);
-
-    if (it != envMap.end()) {
-        return it->second.data;
+    if (auto stored = stored_value(*state_, key)) {
+        return std::move(*stored);
     }
-
-    auto *value = getenv(key_str.c_str());
-    return (value != nullptr) ? std::string(value) : std::string(default_value);
+    return fallback_value(*state_, key).value_or(std::string(default_value));
 }
 
-auto dotenv::value_or(std::string_view key, std::string_view fallback_value)
+auto dotenv::environment::value_or(std::string_view key,
+                                   std::string_view fallback_value) const
     -> std::string {
     return value(key, fallback_value);
 }
 
-auto dotenv::try_value(std::string_view key) noexcept
+auto dotenv::environment::try_value(std::string_view key) const noexcept
     -> std::optional<std::string> {
-    std::lock_guard<std::mutex> lock(envMapMutex);
+    if (auto stored = stored_value(*state_, key)) {
+        return std::move(*stored);
+    }
+    return fallback_value(*state_, key);
+}
+
+auto dotenv::environment::contains(std::string_view key) const -> bool {
+    if (state_->store.read(key, [](const ValueStruct *entry) {
+            return entry != nullptr;
+        })) {
+        return true;
+    }
+    if (!state_->process_env) {
+        return false;
+    }
 
     std::string key_str(key);
-    auto it = envMap.find(key_str);
+    return getenv(key_str.c_str()) != nullptr;
+}
 
-    if (it != envMap.end()) {
-        return it->second.data;
-    }
+auto dotenv::value(std::string_view key, std::string_view default_value)
+    -> std::string {
+    return default_environment().value(key, default_value);
+}
 
-    auto *value = getenv(key_str.c_str());
-    if (value != nullptr) {
-        return std::string(value);
-    }
+auto dotenv::value_or(std::string_view key, std::string_view fallback_value)
+    -> std::string {
+    return default_environment().value_or(key, fallback_value);
+}
 
-    return std::nullopt;
+auto dotenv::try_value(std::string_view key) noexcept
+    -> std::optional<std::string> {
+    return default_environment().try_value(key);
 }
 
 auto dotenv::contains(std::string_view key) -> bool {
-    std::lock_guard<std::mutex> lock(envMapMutex);
+    return default_environment().contains(key);
+}
 
-    std::string key_str(key);
-    auto it = envMap.find(key_str);
+// Conteúdo de `existing` atualizado para o estado fixado: comentários e
+// definições inalteradas ficam como estão, valores alterados são reescritos
+// no lugar, chaves removidas somem e as novas vão para o final em ordem.
+// nullopt se o arquivo já corresponde ao estado.
+static auto patch_content(environment_state &env, std::string_view existing,
+                          const dotenv::detail::env_table &table)
+    -> std::optional<std::string> {
+    std::vector<dotenv::detail::parsed_entry> definitions;
+    // Índice da última definição de cada chave, a que vale na carga
+    std::unordered_map<std::string_view, size_t> last;
+    bool has_references = false;
+    dotenv::detail::parse_content(
+        existing, [&](dotenv::detail::parsed_entry &&entry) {
+            has_references =
+                has_references || (!entry.single_quoted &&
+                                   entry.value.find('$') != std::string::npos);
+            last.insert_or_assign(entry.key, definitions.size());
+            definitions.push_back(std::move(entry));
+        });
+
+    // Valores expandidos, para reconhecer templates carregados com
+    // interpolação eager (o store só guarda o resultado)
+    env_map expanded;
+    if (has_references) {
+        parse_into(env, existing, {.expansion = dotenv::interpolation::eager},
+                   expanded);
+    }
+    const auto unchanged = [&](const dotenv::detail::parsed_entry &definition,
+                               const ValueStruct &stored,
+                               const std::string &value) {
+        if (definition.value == value ||
+            (stored.deferred && definition.value == stored.data)) {
+            return true;
+        }
+        auto it = expanded.find(definition.key);
+        return it != expanded.end() && it->second.data == value;
+    };
 
-    if (it != envMap.end()) {
-        return true;
+    std::string output;
+    output.reserve(existing.size() + 256);
+    bool changed = false;
+    size_t copied = 0; // Bytes de `existing` já tratados
+    for (size_t i = 0; i < definitions.size(); ++i) {
+        const auto &definition = definitions[i];
+        output.append(existing.substr(copied, definition.offset - copied));
+        copied = definition.end;
+
+        const auto *stored = table.find(definition.key);
+        if (stored == nullptr) {
+            changed = true;
+            continue;
+        }
+        const auto &value = pinned_value(table, definition.key, *stored);
+        const bool overridden = last[definition.key] != i;
+        if (overridden || unchanged(definition, *stored, value)) {
+            output.append(existing.substr(
+                definition.offset, definition.end - definition.offset));
+        } else {
+            dotenv::detail::append_assignment(output, definition.key, value);
+            changed = true;
+        }
     }
+    output.append(existing.substr(copied));
 
-    return getenv(key_str.c_str()) != nullptr;
+    for (const auto &[key, stored] : prefixed_entries(table, "")) {
+        if (last.contains(*key)) {
+            continue;
+        }
+        if (!output.empty() && output.back() != '\n') {
+            output += '\n';
+        }
+        dotenv::detail::append_assignment(output, *key,
+                                          pinned_value(table, *key, *stored));
+        changed = true;
+    }
+
+    if (!changed) {
+        return std::nullopt;
+    }
+    return output;
 }
 
-void dotenv::save_to_file(std::string_view path) {
-    std::ofstream output_file{std::string(path)};
-    if (!output_file.is_open()) {
-        throw std::runtime_error("Cannot create output file: " +
-                                 std::string(path));
+void dotenv::environment::save_to_file(std::string_view path,
+                                       const save_options &options) const {
+    const std::string file_path(path);
+    mapped_file existing;
+    const bool patching =
+        options.preserve_layout && map_source(file_path, existing) == 0;
+
+    std::optional<std::string> buffer;
+    {
+        // Estado fixado e consistente, serializado sem travar os shards; a
+        // fixação é liberada antes da escrita para não forçar cópias nos
+        // escritores enquanto o disco trabalha
+        auto [table, generation] = pin_state(*state_);
+        if (patching) {
+            buffer = patch_content(*state_, existing.view(), *table);
+        } else if (options.sorted) {
+            const auto entries = prefixed_entries(*table, "");
+            buffer.emplace().reserve(entries.size() * 32);
+            for (const auto &[key, value] : entries) {
+                detail::append_assignment(*buffer, *key,
+                                          pinned_value(*table, *key, *value));
+            }
+        } else {
+            buffer.emplace().reserve(table->size() * 32);
+            table->for_each(
+                [&](const std::string &key, const ValueStruct &value) {
+                    detail::append_assignment(
+                        *buffer, key, pinned_value(*table, key, value));
+                });
+        }
     }
+    existing.close();
 
-    std::lock_guard<std::mutex> lock(envMapMutex);
-    for (const auto &[key, value] : envMap) {
-        output_file << key << "=" << value.data << "\n";
+    if (!buffer) {
+        return; // O arquivo já corresponde ao store
+    }
+    if (auto error_code = detail::write_file_atomic(file_path, *buffer)) {
+        throw std::runtime_error("Cannot write output file: " + file_path +
+                                 ": " + error_code.message());
     }
 }
 
+void dotenv::save_to_file(std::string_view path, const save_options &options) {
+    default_environment().save_to_file(path, options);
+}
+
 #if DOTENV_HAS_STD_EXPECTED
 std::expected<std::string, dotenv::dotenv_error>
 dotenv::value_expected(std::string_view key) {
-    std::lock_guard<std::mutex> lock(envMapMutex);
-
-    std::string key_str(key);
-    auto it = envMap.find(key_str);
-
-    if (it != envMap.end()) {
-        return it->second.data;
+    if (auto stored = stored_value(defaultState, key)) {
+        return std::move(*stored);
     }
 
+    std::string key_str(key);
     auto *value = getenv(key_str.c_str());
     if (value != nullptr) {
         return std::string(value);
@@ -1104,22 +1919,626 @@ dotenv::value_expected(std::string_view key) {
 // Note: The load() and load_traditional() functions with int/bool parameters
 // are already implemented above in the main implementation section
 
+auto dotenv::where(std::string_view key) -> std::optional<source_location> {
+    std::uint32_t source = 0;
+    source_location location;
+    envStore.read(key, [&](const ValueStruct *stored) {
+        if (stored != nullptr) {
+            source = stored->source;
+            location.line = stored->line;
+            location.offset = stored->offset;
+        }
+    });
+    if (source == 0) {
+        return std::nullopt;
+    }
+    // Caminho resolvido fora do lock do shard
+    location.file = detail::source_path(source);
+    return location;
+}
+
+void dotenv::environment::set(std::string_view key, std::string_view value,
+                              overwrite overwrite_policy) {
+    state_->store.write(key, [&](env_map &envMap) {
+        std::string key_str(key);
+
+        if (overwrite_policy == overwrite::replace) {
+            envMap.insert_or_assign(std::move(key_str),
+                                    ValueStruct(std::string(value), true));
+        } else {
+            // Se overwrite::preserve, só insere se não existir
+            envMap.emplace(std::move(key_str),
+                           ValueStruct(std::string(value), true));
+        }
+    });
+    state_->expansions.invalidate(key);
+}
+
+void dotenv::environment::unset(std::string_view key) {
+    state_->store.erase(key);
+    state_->expansions.invalidate(key);
+}
+
 void dotenv::set(std::string_view key, std::string_view value,
                  overwrite overwrite_policy) {
-    std::lock_guard<std::mutex> lock(envMapMutex);
-    std::string key_str(key);
+    default_environment().set(key, value, overwrite_policy);
+}
+
+void dotenv::unset(std::string_view key) {
+    default_environment().unset(key);
+}
+
+// ===== SOURCE RELOAD =====
+
+namespace {
 
-    if (overwrite_policy == overwrite::replace) {
-        envMap.insert_or_assign(std::move(key_str),
-                                ValueStruct(std::string(value), true));
+struct Subscriber {
+    std::uint64_t id;
+    std::string prefix;
+    dotenv::change_callback callback;
+};
+
+// Observadores registrados; copiados antes da notificação para que os
+// callbacks rodem sem nenhum lock
+std::mutex subscribersMutex;
+std::vector<std::shared_ptr<const Subscriber>> subscribers;
+std::uint64_t nextSubscriberId = 1;
+
+auto with_prefix(const std::vector<std::string> &keys, std::string_view prefix)
+    -> std::vector<std::string> {
+    std::vector<std::string> matching;
+    std::copy_if(keys.begin(), keys.end(), std::back_inserter(matching),
+                 [prefix](const std::string &key) {
+                     return key.starts_with(prefix);
+                 });
+    return matching;
+}
+
+} // namespace
+
+auto dotenv::detail::commit_source(std::string_view path, const env_map &next,
+                                   bool replace, bool apply_system_env)
+    -> change_set {
+    change_set changes;
+    if (std::any_of(next.begin(), next.end(),
+                    [](const auto &entry) { return entry.second.deferred; })) {
+        expansionCache.enable();
+    }
+
+    // Valor literal que a fonte tinha gravado em cada chave alterada ou
+    // removida, para reconhecer no ambiente do processo o que é dela
+    std::unordered_map<std::string, std::string> previous;
+
+    const auto source_id = register_source(path);
+    std::lock_guard sources_lock(defaultState.reload_mutex);
+    auto &sources = defaultState.reload_sources;
+    auto source = sources.find(path);
+    if (source == sources.end()) {
+        source = sources.emplace(std::string(path), env_map{}).first;
+    }
+    auto &owned = source->second;
+    const auto still_owned = [&owned](const std::string &key,
+                                      const ValueStruct *current) {
+        const auto it = owned.find(key);
+        return it != owned.end() && current != nullptr &&
+               current->data == it->second.data &&
+               current->deferred == it->second.deferred;
+    };
+    const auto remember = [&owned, &previous](const std::string &key) {
+        const auto it = owned.find(key);
+        if (it != owned.end() && !it->second.deferred) {
+            previous.insert_or_assign(key, it->second.data);
+        }
+    };
+
+    envStore.write_batch([&](env_store::batch &pending) {
+        // Entradas que vieram deste arquivo por outro caminho (load(),
+        // load_layers()...) também são dele
+        pending.for_each([&](const std::string &key, const ValueStruct &value) {
+            if (value.source == source_id) {
+                owned.insert_or_assign(key, value);
+            }
+        });
+
+        // Chaves que a fonte deixou de definir; as que set() ou outra carga
+        // alteraram desde então ficam com o novo dono
+        for (auto it = owned.begin(); it != owned.end();) {
+            if (next.contains(it->first)) {
+                ++it;
+                continue;
+            }
+            const auto *current = pending.find(it->first);
+            if (still_owned(it->first, current)) {
+                remember(it->first);
+                auto &entries = pending.entries_for(it->first);
+                entries.erase(entries.find(it->first));
+                changes.removed.push_back(it->first);
+            }
+            it = owned.erase(it);
+        }
+
+        for (const auto &[key, value] : next) {
+            const auto *current = pending.find(key);
+            if (current != nullptr && current->data == value.data &&
+                current->deferred == value.deferred) {
+                // Já tem o valor da fonte, seja de quem for a gravação
+                owned.insert_or_assign(key, value);
+                continue;
+            }
+            if (current == nullptr) {
+                changes.added.push_back(key);
+            } else if (owned.contains(key)) {
+                if (!still_owned(key, current)) {
+                    // Alterada por outra origem desde a última recarga
+                    continue;
+                }
+                remember(key);
+                changes.changed.push_back(key);
+            } else if (replace) {
+                changes.changed.push_back(key);
+            } else {
+                // Com overwrite::preserve, chaves de outras origens ficam
+                continue;
+            }
+            pending.entries_for(key).insert_or_assign(key, value);
+            owned.insert_or_assign(key, value);
+        }
+    });
+
+    std::sort(changes.added.begin(), changes.added.end());
+    std::sort(changes.removed.begin(), changes.removed.end());
+    std::sort(changes.changed.begin(), changes.changed.end());
+
+    // Fora dos locks do store
+    for (const auto *keys :
+         {&changes.added, &changes.changed, &changes.removed}) {
+        for (const auto &key : *keys) {
+            expansionCache.invalidate(key);
+        }
+    }
+
+    if (apply_system_env) {
+        // Com preserve, só variáveis do processo que ainda têm o valor
+        // gravado por esta fonte são substituídas ou removidas
+        const auto process_holds_ours = [&previous](const std::string &key) {
+            const auto it = previous.find(key);
+            const char *current = getenv(key.c_str());
+            return it != previous.end() && current != nullptr &&
+                   it->second == current;
+        };
+        for (const auto *keys : {&changes.added, &changes.changed}) {
+            for (const auto &key : *keys) {
+                const auto &value = next.find(key)->second;
+                const auto data =
+                    value.deferred
+                        ? stored_value(defaultState, key).value_or("")
+                        : value.data;
+                set_env(key.c_str(), data.c_str(),
+                        (replace || process_holds_ours(key)) ? 1 : 0);
+            }
+        }
+        for (const auto &key : changes.removed) {
+            if (replace || process_holds_ours(key)) {
+                unset_env(key.c_str());
+            }
+        }
+    }
+
+    return changes;
+}
+
+void dotenv::detail::publish_changes(const change_set &changes) noexcept {
+    if (changes.empty()) {
+        return;
+    }
+
+    try {
+        std::vector<std::shared_ptr<const Subscriber>> targets;
+        {
+            std::lock_guard lock(subscribersMutex);
+            targets = subscribers;
+        }
+
+        for (const auto &target : targets) {
+            try {
+                if (target->prefix.empty()) {
+                    target->callback(changes);
+                    continue;
+                }
+
+                change_set matching{
+                    .added = with_prefix(changes.added, target->prefix),
+                    .removed = with_prefix(changes.removed, target->prefix),
+                    .changed = with_prefix(changes.changed, target->prefix)};
+                if (!matching.empty()) {
+                    target->callback(matching);
+                }
+            } catch (...) {
+                // Um observador com erro não impede a entrega aos demais
+            }
+        }
+    } catch (...) {
+        // Sem memória para copiar a lista: a notificação é perdida
+    }
+}
+
+auto dotenv::subscribe(std::string_view key_prefix, change_callback callback)
+    -> subscription {
+    if (!callback) {
+        throw std::invalid_argument("dotenv::subscribe: empty callback");
+    }
+
+    std::lock_guard lock(subscribersMutex);
+    const auto id = nextSubscriberId++;
+    subscribers.push_back(std::make_shared<const Subscriber>(
+        Subscriber{id, std::string(key_prefix), std::move(callback)}));
+    return subscription(id);
+}
+
+void dotenv::subscription::reset() noexcept {
+    if (id_ == 0) {
+        return;
+    }
+
+    std::lock_guard lock(subscribersMutex);
+    std::erase_if(subscribers, [this](const auto &subscriber) {
+        return subscriber->id == id_;
+    });
+    id_ = 0;
+}
+
+auto dotenv::reload(std::string_view path, const load_options &options) noexcept
+    -> std::pair<dotenv_error, change_set> {
+    try {
+        std::string path_str(path);
+        mapped_file file;
+        if (int error =
+                map_source(path_str, file, options.limits.max_file_size);
+            error != 0) {
+            return {convert_error_code(error), {}};
+        }
+
+        env_map next;
+        detail::parse_source(file.view(), options, next,
+                             detail::register_source(path_str));
+        file.close();
+
+        auto changes = detail::commit_source(
+            path_str, next, options.overwrite_policy == overwrite::replace,
+            options.apply_to_process == process_env_apply::yes);
+
+        detail::publish_changes(changes);
+        return {dotenv_error::success, std::move(changes)};
+    } catch (const detail::budget_exceeded &) {
+        return {dotenv_error::limit_exceeded, {}};
+    } catch (const detail::strict_violation &) {
+        return {dotenv_error::invalid_format, {}};
+    } catch (const std::exception &) {
+        return {dotenv_error::out_of_memory, {}};
+    }
+}
+
+void dotenv::detail::commit_loaded(environment_state &env, env_map &entries,
+                                   const load_options &options) {
+    commit_entries(env, entries,
+                   options.overwrite_policy == overwrite::replace);
+    apply_loaded_keys(env, entries, options);
+}
+
+auto dotenv::load_layers(const std::vector<std::string> &paths,
+                         const load_options &options) noexcept
+    -> std::pair<dotenv_error, int> {
+    return default_environment().load_layers(paths, options);
+}
+
+auto dotenv::environment::load_layers(const std::vector<std::string> &paths,
+                                      const load_options &options) noexcept
+    -> std::pair<dotenv_error, int> {
+    try {
+        struct layer {
+            mapped_file file;
+            env_map entries;
+            detail::key_set literal_keys; // só com interpolação
+            std::uint32_t source{};
+        };
+
+        // Todas as camadas são mapeadas antes da análise: um erro aborta sem
+        // tocar o store. Camadas ausentes são opcionais.
+        std::vector<layer> layers;
+        layers.reserve(paths.size());
+        for (const auto &path : paths) {
+            layer current;
+            current.source = detail::register_source(path);
+            const int error = map_source(path, current.file,
+                                         options.limits.max_file_size);
+            if (error == -1) {
+                continue;
+            }
+            if (error != 0) {
+                return {convert_error_code(error), 0};
+            }
+            layers.push_back(std::move(current));
+        }
+        if (layers.empty()) {
+            return {dotenv_error::file_not_found, 0};
+        }
+
+        const bool interpolate = (options.expansion != interpolation::none);
+        // Com parse paralelo, o sink é chamado uma thread de cada vez
+        std::mutex diagnostics_mutex;
+        load_options layer_options = options;
+        if (options.on_diagnostic && options.parallel_parse) {
+            layer_options.on_diagnostic = [&](const diagnostic &issue) {
+                std::lock_guard lock(diagnostics_mutex);
+                options.on_diagnostic(issue);
+            };
+        }
+        // Um só orçamento para todas as camadas
+        std::optional<detail::budget_meter> meter;
+        if (options.budget != load_budget{}) {
+            meter.emplace(options.budget);
+        }
+        auto *budget = meter ? &*meter : nullptr;
+        auto parse_layer = [interpolate, &layer_options,
+                            budget](layer &target) {
+            detail::parse_entries(target.file.view(), target.entries,
+                                  interpolate ? &target.literal_keys : nullptr,
+                                  target.source, nullptr, layer_options,
+                                  budget);
+            target.file.close();
+        };
+        if (options.parallel_parse && layers.size() > 1) {
+            std::vector<std::future<void>> pending;
+            pending.reserve(layers.size() - 1);
+            for (size_t i = 1; i < layers.size(); ++i) {
+                pending.push_back(std::async(std::launch::async, parse_layer,
+                                             std::ref(layers[i])));
+            }
+            parse_layer(layers.front());
+            for (auto &result : pending) {
+                result.get();
+            }
+        } else {
+            for (auto &current : layers) {
+                parse_layer(current);
+            }
+        }
+
+        // Mescla em ordem de precedência. Cada camada é expandida contra as
+        // anteriores já mescladas, depois store e ambiente do processo.
+        auto &env = *state_;
+        auto store_or_environment = [&env](std::string_view name) {
+            return stored_or_process(env, name);
+        };
+        env_map merged;
+        detail::expansion_memo merged_memo;
+        auto merged_entry =
+            [&merged](std::string_view name) -> std::optional<ValueStruct> {
+            auto it = merged.find(name);
+            if (it == merged.end()) {
+                return std::nullopt;
+            }
+            return it->second;
+        };
+        auto earlier_layers =
+            [&](std::string_view name) -> std::optional<std::string> {
+            auto it = merged.find(name);
+            if (it == merged.end()) {
+                return store_or_environment(name);
+            }
+            if (!it->second.deferred) {
+                return it->second.data;
+            }
+            return detail::expand_deferred(name, it->second.data,
+                                           merged_entry, store_or_environment,
+                                           merged_memo);
+        };
+
+        for (auto &current : layers) {
+            if (interpolate) {
+                expand_entries(current.entries, current.literal_keys,
+                               options.expansion, earlier_layers, budget);
+                merged_memo.clear();
+            }
+            while (!current.entries.empty()) {
+                auto node = current.entries.extract(current.entries.begin());
+                if (auto it = merged.find(node.key()); it != merged.end()) {
+                    it->second = std::move(node.mapped());
+                } else {
+                    merged.insert(std::move(node));
+                }
+            }
+        }
+
+        const int count = static_cast<int>(merged.size());
+        detail::commit_loaded(env, merged, options);
+        return {dotenv_error::success, count};
+    } catch (const detail::budget_exceeded &) {
+        return {dotenv_error::limit_exceeded, 0};
+    } catch (const detail::strict_violation &) {
+        return {dotenv_error::invalid_format, 0};
+    } catch (const std::exception &) {
+        return {dotenv_error::out_of_memory, 0};
+    }
+}
+
+// ===== SNAPSHOT API =====
+
+dotenv::snapshot::snapshot() {
+    auto [pinned, generation] = envStore.pin();
+    table_ = std::move(pinned);
+    generation_ = generation;
+}
+
+auto dotenv::snapshot::find(std::string_view key) const noexcept
+    -> std::optional<std::string_view> {
+    if (!table_) {
+        return std::nullopt;
+    }
+
+    const auto *entry = table_->find(key);
+    if (entry == nullptr) {
+        return std::nullopt;
+    }
+    try {
+        return std::string_view(pinned_value(*table_, key, *entry));
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+}
+
+auto dotenv::snapshot::get(std::string_view key,
+                           std::string_view default_value) const noexcept
+    -> std::string_view {
+    return find(key).value_or(default_value);
+}
+
+auto dotenv::snapshot::contains(std::string_view key) const noexcept -> bool {
+    return table_ && (table_->find(key) != nullptr);
+}
+
+auto dotenv::snapshot::size() const noexcept -> size_t {
+    return table_ ? table_->size() : 0;
+}
+
+auto dotenv::environment::entries() const -> entry_range {
+    entry_range range;
+    auto [table, generation] = pin_state(*state_);
+    range.items_.reserve(table->size());
+    table->for_each([&](const std::string &key, const ValueStruct &value) {
+        range.items_.push_back({key, pinned_value(*table, key, value)});
+    });
+    range.table_ = std::move(table);
+    range.generation_ = generation;
+    return range;
+}
+
+auto dotenv::entries() -> entry_range {
+    return default_environment().entries();
+}
+
+auto dotenv::entries_with_prefix(std::string_view prefix) -> entry_range {
+    return default_environment().entries_with_prefix(prefix);
+}
+
+auto dotenv::environment::entries_with_prefix(std::string_view prefix) const
+    -> entry_range {
+    entry_range range;
+    auto [table, generation] = pin_state(*state_);
+    const auto found = prefixed_entries(*table, prefix);
+    range.items_.reserve(found.size());
+    for (const auto &[key, value] : found) {
+        range.items_.push_back({*key, pinned_value(*table, *key, *value)});
+    }
+    range.table_ = std::move(table);
+    range.generation_ = generation;
+    return range;
+}
+
+// ===== CONSISTENT READS =====
+
+namespace {
+// Tentativas otimistas antes de fixar o store inteiro
+constexpr int optimistic_attempts = 8;
+} // namespace
+
+dotenv::view::view(bool pin_all) {
+    if (pin_all) {
+        auto [pinned, generation] = envStore.pin();
+        table_ = std::move(pinned);
+        generation_ = generation;
     } else {
-        // Se overwrite::preserve, só insere se não existir
-        envMap.emplace(std::move(key_str),
-                       ValueStruct(std::string(value), true));
+        shards_ = std::make_shared<detail::env_table>();
     }
 }
 
-void dotenv::unset(std::string_view key) {
-    std::lock_guard<std::mutex> lock(envMapMutex);
-    envMap.erase(std::string(key));
+auto dotenv::view::table_for(std::string_view key) const
+    -> const detail::env_table * {
+    if (table_) {
+        return table_.get();
+    }
+    const auto index = detail::shard_index(key);
+    if (!shards_->shards[index]) {
+        envStore.pin_shard(*shards_, index);
+    }
+    return shards_.get();
+}
+
+auto dotenv::view::find(std::string_view key) const noexcept
+    -> std::optional<std::string_view> {
+    try {
+        const auto *table = table_for(key);
+        const auto *entry = table->find(key);
+        if (entry != nullptr && entry->deferred && !table_) {
+            // A expansão consulta outras chaves: fixa o estado inteiro, que
+            // read_consistent confere contra os shards já fixados
+            auto [pinned, generation] = envStore.pin();
+            table_ = std::move(pinned);
+            generation_ = generation;
+            table = table_.get();
+            entry = table->find(key);
+        }
+        if (entry == nullptr) {
+            return std::nullopt;
+        }
+        return std::string_view(pinned_value(*table, key, *entry));
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+}
+
+auto dotenv::view::get(std::string_view key,
+                       std::string_view default_value) const noexcept
+    -> std::string_view {
+    return find(key).value_or(default_value);
+}
+
+auto dotenv::view::contains(std::string_view key) const noexcept -> bool {
+    try {
+        return table_for(key)->find(key) != nullptr;
+    } catch (const std::exception &) {
+        return false;
+    }
+}
+
+auto dotenv::view::validated() const noexcept -> bool {
+    if (!table_) {
+        return envStore.validate(*shards_);
+    }
+    // Com o estado inteiro fixado, as leituras anteriores por shard valem se
+    // esses shards não mudaram até a fixação
+    for (size_t i = 0; i < detail::store_shard_count; ++i) {
+        if (shards_->shards[i] &&
+            shards_->generations[i] != table_->generations[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void dotenv::view::reset() noexcept {
+    shards_->release();
+    table_.reset();
+}
+
+auto dotenv::read_consistent(const std::function<void(const view &)> &reader)
+    -> std::uint64_t {
+    view current(false);
+    for (int attempt = 0; attempt < optimistic_attempts; ++attempt) {
+        if (attempt != 0) {
+            current.reset();
+        }
+        reader(current);
+        // Só os shards lidos são conferidos: escritas em outros shards não
+        // invalidam a leitura
+        const auto generation =
+            current.table_ ? current.generation_ : envStore.generation();
+        if (current.validated()) {
+            return generation;
+        }
+    }
+
+    view pinned(true);
+    reader(pinned);
+    return pinned.generation_;
 }
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "dotenv_types.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+
+// Consumo de um load_budget durante uma carga. Cabeçalho interno, não
+// instalado.
+namespace dotenv::detail {
+
+// Lançada quando o orçamento se esgota; quem carrega descarta o que já foi
+// analisado e retorna dotenv_error::limit_exceeded, sem commit parcial
+struct budget_exceeded : std::runtime_error {
+    budget_exceeded() : std::runtime_error("dotenv: load budget exceeded") {}
+};
+
+// Contadores de uma carga. Atômicos porque load_layers com parallel_parse
+// analisa as camadas em threads separadas contra o mesmo orçamento.
+class budget_meter {
+  public:
+    explicit budget_meter(const load_budget &budget)
+        : budget_(budget), deadline_(deadline_after(budget.max_duration)) {}
+
+    // Linhas físicas lidas; o relógio é consultado a cada clock_stride
+    void charge_lines(std::size_t count) {
+        const auto before =
+            lines_.fetch_add(count, std::memory_order_relaxed);
+        if (before + count > budget_.max_lines) {
+            throw budget_exceeded();
+        }
+        if (before / clock_stride != (before + count) / clock_stride) {
+            check_time();
+        }
+    }
+
+    // Bytes guardados para o commit: chaves, valores e expansões
+    void charge_memory(std::size_t bytes) {
+        const auto before =
+            memory_.fetch_add(bytes, std::memory_order_relaxed);
+        if (before + bytes > budget_.max_memory) {
+            throw budget_exceeded();
+        }
+    }
+
+    void check_time() const {
+        if (clock::now() > deadline_) {
+            throw budget_exceeded();
+        }
+    }
+
+  private:
+    using clock = std::chrono::steady_clock;
+    static constexpr std::size_t clock_stride = 1024;
+
+    static auto deadline_after(std::chrono::nanoseconds limit)
+        -> clock::time_point {
+        const auto now = clock::now();
+        if (limit >= clock::time_point::max() - now) {
+            return clock::time_point::max();
+        }
+        return now + std::chrono::duration_cast<clock::duration>(limit);
+    }
+
+    load_budget budget_;
+    clock::time_point deadline_;
+    std::atomic<std::size_t> lines_{0};
+    std::atomic<std::size_t> memory_{0};
+};
+
+} // namespace dotenv::detail
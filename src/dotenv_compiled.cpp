@@ -0,0 +1,303 @@
+#include "dotenv.hpp"
+#include "dotenv_budget.hpp"
+#include "dotenv_fingerprint.hpp"
+#include "dotenv_image.hpp"
+#include "dotenv_mmap.hpp"
+#include "dotenv_store.hpp"
+#include "dotenv_writer.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace {
+
+using dotenv::detail::image::entry_record;
+using dotenv::detail::image::image_header;
+using dotenv::detail::image::read_at;
+
+constexpr auto align8(std::uint64_t offset) noexcept -> std::uint64_t {
+    return (offset + 7) & ~std::uint64_t{7};
+}
+
+// `count` elementos de `size` bytes a partir de `offset` cabem na imagem
+auto fits(std::uint64_t offset, std::uint64_t count, std::uint64_t size,
+          std::uint64_t image_size) noexcept -> bool {
+    return offset <= image_size && count <= (image_size - offset) / size;
+}
+
+} // namespace
+
+auto dotenv::detail::image::build(entry_list &entries,
+                                  std::uint64_t source_hash)
+    -> std::optional<std::string> {
+    std::sort(entries.begin(), entries.end());
+
+    // Pool de strings e registros
+    std::string strings;
+    std::vector<entry_record> records;
+    records.reserve(entries.size());
+    for (const auto &[key, value] : entries) {
+        entry_record record{};
+        record.hash = content_hash(key);
+        record.key_offset = static_cast<std::uint32_t>(strings.size());
+        record.key_size = static_cast<std::uint32_t>(key.size());
+        strings += key;
+        record.value_offset = static_cast<std::uint32_t>(strings.size());
+        record.value_size = static_cast<std::uint32_t>(value.size());
+        strings += value;
+        strings += '\0';
+        if (strings.size() > std::numeric_limits<std::uint32_t>::max()) {
+            return std::nullopt;
+        }
+        records.push_back(record);
+    }
+
+    // Índice com no máximo 50% de ocupação
+    const std::uint64_t bucket_count =
+        records.empty() ? 0 : std::bit_ceil(records.size() * 2);
+    std::vector<std::uint32_t> buckets(bucket_count, 0);
+    for (size_t i = 0; i < records.size(); ++i) {
+        auto slot = records[i].hash & (bucket_count - 1);
+        while (buckets[slot] != 0) {
+            slot = (slot + 1) & (bucket_count - 1);
+        }
+        buckets[slot] = static_cast<std::uint32_t>(i + 1);
+    }
+
+    image_header header{};
+    header.magic = magic;
+    header.version = version;
+    header.entry_count = records.size();
+    header.bucket_count = bucket_count;
+    header.index_offset = sizeof(image_header);
+    header.entries_offset =
+        align8(header.index_offset + bucket_count * sizeof(std::uint32_t));
+    header.strings_offset =
+        header.entries_offset + records.size() * sizeof(entry_record);
+    header.strings_size = strings.size();
+    header.source_hash = source_hash;
+
+    std::string image(header.strings_offset + strings.size(), '\0');
+    std::memcpy(image.data(), &header, sizeof(header));
+    if (!records.empty()) {
+        std::memcpy(image.data() + header.index_offset, buckets.data(),
+                    buckets.size() * sizeof(std::uint32_t));
+        std::memcpy(image.data() + header.entries_offset, records.data(),
+                    records.size() * sizeof(entry_record));
+        std::memcpy(image.data() + header.strings_offset, strings.data(),
+                    strings.size());
+    }
+    return image;
+}
+
+auto dotenv::detail::image::parse_layout(std::string_view data) noexcept
+    -> std::optional<layout> {
+    if (data.size() < sizeof(image_header)) {
+        return std::nullopt;
+    }
+    const auto header = read_at<image_header>(data, 0);
+    if (header.magic != magic || header.version != version) {
+        return std::nullopt;
+    }
+
+    const auto count = header.entry_count;
+    const auto buckets = header.bucket_count;
+    if (!fits(header.index_offset, buckets, sizeof(std::uint32_t),
+              data.size()) ||
+        !fits(header.entries_offset, count, sizeof(entry_record),
+              data.size()) ||
+        !fits(header.strings_offset, header.strings_size, 1, data.size()) ||
+        (count != 0 && (!std::has_single_bit(buckets) || buckets <= count)) ||
+        count > std::numeric_limits<std::uint32_t>::max()) {
+        return std::nullopt;
+    }
+
+    return layout{
+        .index = data.substr(header.index_offset,
+                             buckets * sizeof(std::uint32_t)),
+        .entries = data.substr(header.entries_offset,
+                               count * sizeof(entry_record)),
+        .strings = data.substr(header.strings_offset, header.strings_size),
+        .entry_count = static_cast<size_t>(count),
+        .bucket_count = static_cast<size_t>(buckets),
+        .source_hash = header.source_hash};
+}
+
+auto dotenv::detail::image::records_valid(const layout &view) noexcept
+    -> bool {
+    for (size_t i = 0; i < view.bucket_count; ++i) {
+        if (read_at<std::uint32_t>(view.index, i * sizeof(std::uint32_t)) >
+            view.entry_count) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < view.entry_count; ++i) {
+        if (!entry_at(view, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto dotenv::detail::image::entry_at(const layout &view, size_t index) noexcept
+    -> std::optional<std::pair<std::string_view, std::string_view>> {
+    const auto record =
+        read_at<entry_record>(view.entries, index * sizeof(entry_record));
+    const auto &strings = view.strings;
+    // O valor precisa do '\0' final dentro do pool
+    if (std::uint64_t{record.key_offset} + record.key_size > strings.size() ||
+        std::uint64_t{record.value_offset} + record.value_size >=
+            strings.size() ||
+        strings[record.value_offset + record.value_size] != '\0') {
+        return std::nullopt;
+    }
+    return std::pair{strings.substr(record.key_offset, record.key_size),
+                     strings.substr(record.value_offset, record.value_size)};
+}
+
+auto dotenv::detail::image::find(const layout &view,
+                                 std::string_view key) noexcept
+    -> std::optional<std::string_view> {
+    if (view.bucket_count == 0) {
+        return std::nullopt;
+    }
+
+    const auto hash = content_hash(key);
+    const auto mask = view.bucket_count - 1;
+    // Limitado a bucket_count sondagens mesmo se o índice estiver cheio
+    for (size_t probe = 0, slot = hash & mask; probe < view.bucket_count;
+         ++probe, slot = (slot + 1) & mask) {
+        const auto entry =
+            read_at<std::uint32_t>(view.index, slot * sizeof(std::uint32_t));
+        if (entry == 0 || entry > view.entry_count) {
+            break;
+        }
+        const auto record = read_at<entry_record>(
+            view.entries, (entry - 1) * sizeof(entry_record));
+        if (record.hash != hash) {
+            continue;
+        }
+        auto found = entry_at(view, entry - 1);
+        if (found && found->first == key) {
+            return found->second;
+        }
+    }
+    return std::nullopt;
+}
+
+auto dotenv::compile(std::string_view source, std::string_view output,
+                     const load_options &options) noexcept -> dotenv_error {
+    try {
+        mapped_file file;
+        const std::string source_path(source);
+        if (!file.map(source_path)) {
+            std::error_code error_code;
+            return std::filesystem::exists(source_path, error_code)
+                       ? dotenv_error::permission_denied
+                       : dotenv_error::file_not_found;
+        }
+
+        auto compile_options = options;
+        if (compile_options.expansion == interpolation::lazy) {
+            compile_options.expansion = interpolation::eager;
+        }
+        detail::env_map entries;
+        detail::parse_source(file.view(), compile_options, entries);
+        const auto source_hash = detail::content_hash(file.view());
+        file.close();
+
+        detail::image::entry_list image_entries;
+        image_entries.reserve(entries.size());
+        for (const auto &[key, value] : entries) {
+            image_entries.emplace_back(key, value.data);
+        }
+        auto image = detail::image::build(image_entries, source_hash);
+        if (!image) {
+            return dotenv_error::invalid_argument;
+        }
+
+        return detail::write_file_atomic(std::string(output), *image)
+                   ? dotenv_error::permission_denied
+                   : dotenv_error::success;
+    } catch (const detail::budget_exceeded &) {
+        return dotenv_error::limit_exceeded;
+    } catch (const detail::strict_violation &) {
+        return dotenv_error::invalid_format;
+    } catch (const std::exception &) {
+        return dotenv_error::out_of_memory;
+    }
+}
+
+auto dotenv::load_compiled(std::string_view path) noexcept
+    -> std::pair<dotenv_error, compiled_env> {
+    try {
+        auto file = std::make_shared<mapped_file>();
+        const std::string image_path(path);
+        if (!file->map(image_path)) {
+            std::error_code error_code;
+            return {std::filesystem::exists(image_path, error_code)
+                        ? dotenv_error::permission_denied
+                        : dotenv_error::file_not_found,
+                    {}};
+        }
+
+        const auto layout = detail::image::parse_layout(file->view());
+        if (!layout || !detail::image::records_valid(*layout)) {
+            return {dotenv_error::invalid_format, {}};
+        }
+
+        compiled_env env;
+        env.index_ = layout->index;
+        env.entries_ = layout->entries;
+        env.strings_ = layout->strings;
+        env.entry_count_ = layout->entry_count;
+        env.bucket_count_ = layout->bucket_count;
+        env.source_hash_ = layout->source_hash;
+        env.file_ = std::move(file);
+        return {dotenv_error::success, std::move(env)};
+    } catch (const std::exception &) {
+        return {dotenv_error::out_of_memory, {}};
+    }
+}
+
+auto dotenv::compiled_env::view() const noexcept -> detail::image::layout {
+    return {.index = index_,
+            .entries = entries_,
+            .strings = strings_,
+            .entry_count = entry_count_,
+            .bucket_count = bucket_count_,
+            .source_hash = source_hash_};
+}
+
+auto dotenv::compiled_env::find(std::string_view key) const noexcept
+    -> std::optional<std::string_view> {
+    return detail::image::find(view(), key);
+}
+
+auto dotenv::compiled_env::get(std::string_view key,
+                               std::string_view default_value) const noexcept
+    -> std::string_view {
+    return find(key).value_or(default_value);
+}
+
+auto dotenv::compiled_env::contains(std::string_view key) const noexcept
+    -> bool {
+    return find(key).has_value();
+}
+
+void dotenv::compiled_env::for_each(
+    const std::function<void(std::string_view key, std::string_view value)>
+        &visitor) const {
+    const auto layout = view();
+    for (size_t i = 0; i < entry_count_; ++i) {
+        auto [key, value] = *detail::image::entry_at(layout, i);
+        visitor(key, value);
+    }
+}
@@ -0,0 +1,181 @@
+#include "dotenv.hpp"
+#include "dotenv_mmap.hpp"
+#include "dotenv_store.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using dotenv::detail::env_map;
+using dotenv::detail::ValueStruct;
+
+namespace {
+
+// Arquivos até este tamanho são lidos com um único pread(); maiores são
+// mapeados. Secrets costumam ter poucos bytes, certificados alguns KiB.
+constexpr size_t small_file_limit = 64 * 1024;
+
+enum class read_status { ok, missing, failed, too_large };
+
+// Nomes aceitos como chave. Volumes do Kubernetes contêm "..data" e um
+// diretório com timestamp, ambos começando com '.'; setenv() rejeita '='.
+auto is_key_file(std::string_view name) noexcept -> bool {
+    return !name.empty() && name.front() != '.' &&
+           name.find('=') == std::string_view::npos;
+}
+
+// Remove um único fim de linha ("\n" ou "\r\n")
+void strip_newline(std::string &value) noexcept {
+    if (value.ends_with('\n')) {
+        value.pop_back();
+        if (value.ends_with('\r')) {
+            value.pop_back();
+        }
+    }
+}
+
+auto read_mapped(const std::filesystem::path &path, std::string &value,
+                 size_t max_size) -> read_status {
+    dotenv::mapped_file file;
+    if (!file.map(path.string())) {
+        std::error_code error_code;
+        return std::filesystem::exists(path, error_code)
+                   ? read_status::failed
+                   : read_status::missing;
+    }
+    if (file.view().size() > max_size) {
+        return read_status::too_large;
+    }
+    value.assign(file.view());
+    return read_status::ok;
+}
+
+#ifndef _WIN32
+// Lê o arquivo aberto em `fd`; arquivos pequenos com um único pread()
+auto read_descriptor(int fd, const std::filesystem::path &path,
+                     std::string &value, size_t max_size) -> read_status {
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        return read_status::failed;
+    }
+    const auto size = static_cast<size_t>(info.st_size);
+    if (size > max_size) {
+        return read_status::too_large;
+    }
+    if (size > small_file_limit) {
+        return read_mapped(path, value, max_size);
+    }
+
+    value.resize(size);
+    size_t done = 0;
+    while (done < size) {
+        const auto bytes = ::pread(fd, value.data() + done, size - done,
+                                   static_cast<off_t>(done));
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes < 0) {
+            return read_status::failed;
+        }
+        if (bytes == 0) {
+            break; // O arquivo encolheu depois do fstat()
+        }
+        done += static_cast<size_t>(bytes);
+    }
+    value.resize(done);
+    return read_status::ok;
+}
+#endif
+
+auto read_file(const std::filesystem::path &path, std::string &value,
+               size_t max_size) -> read_status {
+#ifdef _WIN32
+    return read_mapped(path, value, max_size);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return (errno == ENOENT) ? read_status::missing : read_status::failed;
+    }
+    const auto status = read_descriptor(fd, path, value, max_size);
+    ::close(fd);
+    return status;
+#endif
+}
+
+} // namespace
+
+auto dotenv::load_directory(std::string_view path,
+                            const load_options &options) noexcept
+    -> std::pair<dotenv_error, int> {
+    return default_environment().load_directory(path, options);
+}
+
+auto dotenv::environment::load_directory(std::string_view path,
+                                         const load_options &options) noexcept
+    -> std::pair<dotenv_error, int> {
+    try {
+        const std::filesystem::path directory(path);
+        std::error_code error_code;
+        std::filesystem::directory_iterator it(directory, error_code);
+        if (error_code) {
+            if (error_code == std::errc::no_such_file_or_directory) {
+                return {dotenv_error::file_not_found, 0};
+            }
+            if (error_code == std::errc::not_a_directory) {
+                return {dotenv_error::invalid_argument, 0};
+            }
+            return {dotenv_error::permission_denied, 0};
+        }
+
+        // Tudo é lido antes de tocar o store
+        env_map entries;
+        for (; it != std::filesystem::directory_iterator();
+             it.increment(error_code)) {
+            auto name = it->path().filename().string();
+            // is_regular_file() segue os symlinks das chaves do Kubernetes;
+            // symlinks quebrados são ignorados
+            std::error_code type_error;
+            if (!is_key_file(name) || !it->is_regular_file(type_error)) {
+                continue;
+            }
+
+            std::string value;
+            const auto status =
+                read_file(it->path(), value, options.limits.max_file_size);
+            if (status == read_status::missing) {
+                continue; // Removido durante a carga
+            }
+            if (status == read_status::too_large) {
+                return {dotenv_error::limit_exceeded, 0};
+            }
+            if (status == read_status::failed) {
+                return {dotenv_error::permission_denied, 0};
+            }
+            if (options.strip_trailing_newline) {
+                strip_newline(value);
+            }
+            ValueStruct entry(std::move(value), true);
+            detail::set_location(
+                entry, detail::register_source(it->path().string()), 1, 0);
+            entries.insert_or_assign(std::move(name), std::move(entry));
+        }
+        if (error_code) {
+            return {dotenv_error::permission_denied, 0};
+        }
+
+        const int count = static_cast<int>(entries.size());
+        detail::commit_loaded(*state_, entries, options);
+        return {dotenv_error::success, count};
+    } catch (const std::exception &) {
+        return {dotenv_error::out_of_memory, 0};
+    }
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <filesystem>
+#include <system_error>
+#else
+#include <sys/stat.h>
+#endif
+
+// Detecção de mudanças em arquivos .env: identidade e metadados do arquivo
+// mais um hash rápido do conteúdo. Cabeçalho interno, não instalado.
+namespace dotenv::detail {
+
+namespace xxh64 {
+
+inline constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+inline constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+inline constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+inline constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+inline constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+inline auto read64(const char *ptr) noexcept -> std::uint64_t {
+    std::uint64_t value = 0;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+inline auto read32(const char *ptr) noexcept -> std::uint32_t {
+    std::uint32_t value = 0;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+inline auto round(std::uint64_t acc, std::uint64_t input) noexcept
+    -> std::uint64_t {
+    acc += input * prime2;
+    acc = std::rotl(acc, 31);
+    return acc * prime1;
+}
+
+inline auto merge_round(std::uint64_t acc, std::uint64_t value) noexcept
+    -> std::uint64_t {
+    acc ^= round(0, value);
+    return acc * prime1 + prime4;
+}
+
+} // namespace xxh64
+
+/**
+ * @brief Hash de 64 bits do conteúdo (algoritmo XXH64)
+ *
+ * Lê palavras em ordem nativa: o resultado só é comparado dentro do mesmo
+ * processo, então não precisa ser portável entre arquiteturas.
+ */
+inline auto content_hash(std::string_view data,
+                         std::uint64_t seed = 0) noexcept -> std::uint64_t {
+    using namespace xxh64;
+
+    const char *ptr = data.data();
+    const char *const end = ptr + data.size();
+    std::uint64_t hash = 0;
+
+    if (data.size() >= 32) {
+        std::uint64_t acc1 = seed + prime1 + prime2;
+        std::uint64_t acc2 = seed + prime2;
+        std::uint64_t acc3 = seed;
+        std::uint64_t acc4 = seed - prime1;
+
+        for (const char *limit = end - 32; ptr <= limit; ptr += 32) {
+            acc1 = round(acc1, read64(ptr));
+            acc2 = round(acc2, read64(ptr + 8));
+            acc3 = round(acc3, read64(ptr + 16));
+            acc4 = round(acc4, read64(ptr + 24));
+        }
+
+        hash = std::rotl(acc1, 1) + std::rotl(acc2, 7) + std::rotl(acc3, 12) +
+               std::rotl(acc4, 18);
+        hash = merge_round(hash, acc1);
+        hash = merge_round(hash, acc2);
+        hash = merge_round(hash, acc3);
+        hash = merge_round(hash, acc4);
+    } else {
+        hash = seed + prime5;
+    }
+
+    hash += static_cast<std::uint64_t>(data.size());
+
+    for (; ptr + 8 <= end; ptr += 8) {
+        hash ^= round(0, read64(ptr));
+        hash = std::rotl(hash, 27) * prime1 + prime4;
+    }
+    if (ptr + 4 <= end) {
+        hash ^= static_cast<std::uint64_t>(read32(ptr)) * prime1;
+        hash = std::rotl(hash, 23) * prime2 + prime3;
+        ptr += 4;
+    }
+    for (; ptr < end; ++ptr) {
+        hash ^= static_cast<std::uint64_t>(static_cast<unsigned char>(*ptr)) *
+                prime5;
+        hash = std::rotl(hash, 11) * prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// Intervalo em que um mtime ainda pode mudar sem alterar o valor gravado
+// (granularidade do sistema de arquivos); dentro dele, confere o conteúdo
+inline constexpr std::int64_t racy_mtime_window_ns = 1'000'000'000;
+
+struct file_fingerprint {
+    std::uint64_t device{};
+    std::uint64_t inode{};
+    std::uint64_t size{};
+    std::int64_t mtime_ns{};
+    std::uint64_t content_hash{};
+    // Relógio de parede quando a impressão digital foi tirada
+    std::int64_t recorded_ns{};
+
+    // Mesmos metadados e mtime antigo o suficiente para ser confiável
+    [[nodiscard]] auto
+    same_metadata(const file_fingerprint &other) const noexcept -> bool {
+        return device == other.device && inode == other.inode &&
+               size == other.size && mtime_ns == other.mtime_ns &&
+               mtime_ns + racy_mtime_window_ns < recorded_ns;
+    }
+};
+
+/**
+ * @brief Lê identidade e metadados do arquivo (sem o hash do conteúdo)
+ * @return false se o arquivo não puder ser consultado
+ */
+inline auto read_fingerprint(const std::string &path,
+                             file_fingerprint &fingerprint) -> bool {
+#ifdef _WIN32
+    std::error_code error_code;
+    const auto size = std::filesystem::file_size(path, error_code);
+    if (error_code) {
+        return false;
+    }
+    const auto mtime = std::filesystem::last_write_time(path, error_code);
+    if (error_code) {
+        return false;
+    }
+    fingerprint.size = static_cast<std::uint64_t>(size);
+    fingerprint.mtime_ns = static_cast<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::clock_cast<std::chrono::system_clock>(mtime)
+                .time_since_epoch())
+            .count());
+#else
+    struct stat file_stat {};
+    if (::stat(path.c_str(), &file_stat) != 0) {
+        return false;
+    }
+    fingerprint.device = static_cast<std::uint64_t>(file_stat.st_dev);
+    fingerprint.inode = static_cast<std::uint64_t>(file_stat.st_ino);
+    fingerprint.size = static_cast<std::uint64_t>(file_stat.st_size);
+#ifdef __APPLE__
+    const auto &mtime = file_stat.st_mtimespec;
+#else
+    const auto &mtime = file_stat.st_mtim;
+#endif
+    fingerprint.mtime_ns = static_cast<std::int64_t>(mtime.tv_sec) *
+                               1'000'000'000 +
+                           static_cast<std::int64_t>(mtime.tv_nsec);
+#endif
+    fingerprint.recorded_ns = static_cast<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    return true;
+}
+
+} // namespace dotenv::detail
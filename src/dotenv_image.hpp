@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Imagem binária de um conjunto de variáveis, independente de posição: só
+// offsets relativos, então pode ser lida de um arquivo mapeado (compile) ou
+// de memória compartilhada. Cabeçalho interno, não instalado.
+//
+// Formato (ordem de bytes nativa, offsets a partir do início da imagem):
+//
+//   cabeçalho    image_header
+//   índice       bucket_count x uint32: 1 + índice do registro, 0 = vazio
+//   registros    entry_count x entry_record, ordenados por chave
+//   strings      chaves e valores; cada valor termina em '\0'
+//
+// O índice usa endereçamento aberto com sondagem linear sobre o XXH64 da
+// chave; bucket_count é potência de dois maior que entry_count.
+namespace dotenv::detail::image {
+
+inline constexpr std::array<char, 8> magic = {'D', 'O', 'T', 'E',
+                                              'N', 'V', 'C', '\0'};
+// Lido em ordem nativa: uma imagem de outra arquitetura não confere
+inline constexpr std::uint32_t version = 1;
+
+struct image_header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t flags; // Reservado
+    std::uint64_t entry_count;
+    std::uint64_t bucket_count;
+    std::uint64_t index_offset;
+    std::uint64_t entries_offset;
+    std::uint64_t strings_offset;
+    std::uint64_t strings_size;
+    std::uint64_t source_hash;
+};
+
+struct entry_record {
+    std::uint64_t hash;
+    std::uint32_t key_offset; // Relativos ao início das strings
+    std::uint32_t key_size;
+    std::uint32_t value_offset;
+    std::uint32_t value_size;
+};
+
+static_assert(sizeof(image_header) == 72);
+static_assert(sizeof(entry_record) == 24);
+
+template <class T>
+auto read_at(std::string_view data, size_t offset) noexcept -> T {
+    T value{};
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+// Seções de uma imagem cujo cabeçalho e limites conferem
+struct layout {
+    std::string_view index;   // Buckets do índice
+    std::string_view entries; // Tabela de registros
+    std::string_view strings; // Pool de strings
+    size_t entry_count{};
+    size_t bucket_count{};
+    std::uint64_t source_hash{};
+};
+
+using entry_list = std::vector<std::pair<std::string_view, std::string_view>>;
+
+// Monta a imagem; ordena `entries` por chave. nullopt se o pool de strings
+// passar de 4 GiB.
+auto build(entry_list &entries, std::uint64_t source_hash)
+    -> std::optional<std::string>;
+
+// Confere cabeçalho, versão e se as seções cabem em `data`
+auto parse_layout(std::string_view data) noexcept -> std::optional<layout>;
+
+// Confere todos os buckets e registros, O(n); após isso as consultas não
+// encontram offsets inválidos
+auto records_valid(const layout &view) noexcept -> bool;
+
+// Chave e valor do registro `index`; nullopt se os offsets não couberem no
+// pool (imagem corrompida ou lida durante uma publicação)
+auto entry_at(const layout &view, size_t index) noexcept
+    -> std::optional<std::pair<std::string_view, std::string_view>>;
+
+// Valor de `key`; todas as leituras são verificadas contra os limites
+auto find(const layout &view, std::string_view key) noexcept
+    -> std::optional<std::string_view>;
+
+} // namespace dotenv::detail::image
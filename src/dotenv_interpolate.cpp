@@ -0,0 +1,459 @@
+#include "dotenv_interpolate.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using dotenv::detail::budget_meter;
+using dotenv::detail::entry_lookup;
+using dotenv::detail::env_map;
+using dotenv::detail::expansion_memo;
+using dotenv::detail::external_lookup;
+using dotenv::detail::key_set;
+using dotenv::detail::string_hash;
+using dotenv::detail::ValueStruct;
+
+// Limite de aninhamento de referências, evita estouro de pilha em cadeias
+// patológicas. Na expansão eager excedê-lo falha a carga; na adiada a
+// referência é tratada como não definida.
+constexpr size_t max_expansion_depth = 256;
+
+constexpr auto is_name_start(char chr) noexcept -> bool {
+    return (chr >= 'A' && chr <= 'Z') || (chr >= 'a' && chr <= 'z') ||
+           chr == '_';
+}
+
+constexpr auto is_name_char(char chr) noexcept -> bool {
+    return is_name_start(chr) || (chr >= '0' && chr <= '9');
+}
+
+// Tamanho do nome de variável no início de `text` (0 se não houver)
+auto name_length(std::string_view text) noexcept -> size_t {
+    if (text.empty() || !is_name_start(text[0])) {
+        return 0;
+    }
+    size_t length = 1;
+    while (length < text.size() && is_name_char(text[length])) {
+        ++length;
+    }
+    return length;
+}
+
+// Posição do '}' que fecha um "${" aberto antes de `start`, considerando
+// referências aninhadas no default
+auto closing_brace(std::string_view text, size_t start) noexcept -> size_t {
+    size_t depth = 1;
+    for (size_t i = start; i < text.size(); ++i) {
+        if (text[i] == '\\' && i + 1 < text.size()) {
+            ++i;
+        } else if (text[i] == '$' && i + 1 < text.size() &&
+                   text[i + 1] == '{') {
+            ++depth;
+            ++i;
+        } else if (text[i] == '}' && --depth == 0) {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+// Referência que começa no '$' em `pos`
+struct reference {
+    std::string_view name{};     // vazio: sintaxe não suportada
+    std::string_view fallback{}; // texto do default (sem ":-")
+    bool has_default{false};
+    size_t end{0};               // posição seguinte à referência
+};
+
+auto parse_reference(std::string_view text, size_t pos) noexcept
+    -> reference {
+    if (pos + 1 < text.size() && text[pos + 1] == '{') {
+        const auto close = closing_brace(text, pos + 2);
+        if (close == std::string_view::npos) {
+            return {.end = text.size()};
+        }
+
+        const auto body = text.substr(pos + 2, close - pos - 2);
+        const auto length = name_length(body);
+        const auto modifier = body.substr(length);
+        const bool has_default = modifier.starts_with(":-");
+        if (length == 0 || (!modifier.empty() && !has_default)) {
+            return {.end = close + 1};
+        }
+        return {.name = body.substr(0, length),
+                .fallback = has_default ? modifier.substr(2)
+                                        : std::string_view{},
+                .has_default = has_default,
+                .end = close + 1};
+    }
+
+    const auto length = name_length(text.substr(pos + 1));
+    if (length == 0) {
+        return {.end = pos + 1};
+    }
+    return {.name = text.substr(pos + 1, length), .end = pos + 1 + length};
+}
+
+/**
+ * Expande `text` em `out`. resolve(name, depth) devolve o valor de uma
+ * referência (std::optional de string ou string_view; nullopt = não
+ * definida). Sintaxe não suportada é copiada literalmente.
+ */
+template <class Resolve>
+void expand_text(std::string_view text, std::string &out, size_t depth,
+                 Resolve &resolve) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        const auto special = text.find_first_of("$\\", pos);
+        if (special == std::string_view::npos) {
+            out.append(text.substr(pos));
+            return;
+        }
+        out.append(text.substr(pos, special - pos));
+        pos = special;
+
+        if (text[pos] == '\\') {
+            // \$ produz um '$' literal; outras barras são preservadas
+            const bool escaped_dollar =
+                pos + 1 < text.size() && text[pos + 1] == '$';
+            out += escaped_dollar ? '$' : '\\';
+            pos += escaped_dollar ? 2 : 1;
+            continue;
+        }
+
+        const auto ref = parse_reference(text, pos);
+        if (ref.name.empty()) {
+            out.append(text.substr(pos, ref.end - pos));
+            pos = ref.end;
+            continue;
+        }
+
+        auto value = resolve(ref.name, depth);
+        if (value && !(ref.has_default && value->empty())) {
+            out.append(*value);
+        } else if (ref.has_default) {
+            expand_text(ref.fallback, out, depth + 1, resolve);
+        }
+        pos = ref.end;
+    }
+}
+
+class interpolator {
+  public:
+    interpolator(env_map &entries, const key_set &literal_keys,
+                 const external_lookup &lookup, budget_meter *meter)
+        : entries_(entries), literal_keys_(literal_keys), lookup_(lookup),
+          meter_(meter) {}
+
+    void run() {
+        for (auto &[key, value] : entries_) {
+            (void)resolve_entry(key, value, 0);
+        }
+    }
+
+    [[nodiscard]] auto cycles() const noexcept -> size_t { return cycles_; }
+
+  private:
+    enum class state : std::uint8_t { pending, expanding, done };
+
+    struct node {
+        state status{state::pending};
+        // Maior profundidade, relativa à entrada, em que uma referência a
+        // outra entrada do arquivo foi resolvida durante a expansão
+        size_t height{0};
+    };
+
+    // Valor expandido de uma entrada do arquivo; nullopt dentro de um ciclo.
+    // Uma entrada já expandida conta sua altura, então o limite de
+    // profundidade falha do mesmo jeito em qualquer ordem de iteração.
+    auto resolve_entry(const std::string &key, ValueStruct &value,
+                       size_t depth) -> std::optional<std::string_view> {
+        // Referências a valores de unordered_map sobrevivem a rehash
+        auto &current = states_[key];
+        if (current.status == state::done) {
+            if (depth + current.height > max_expansion_depth) {
+                throw dotenv::detail::expansion_too_deep();
+            }
+            entry_height_ = current.height;
+            return std::string_view(value.data);
+        }
+        if (current.status == state::expanding) {
+            ++cycles_;
+            return std::nullopt;
+        }
+        if (depth > max_expansion_depth) {
+            throw dotenv::detail::expansion_too_deep();
+        }
+        if (literal_keys_.contains(key)) {
+            current.status = state::done;
+            entry_height_ = 0;
+            return std::string_view(value.data);
+        }
+
+        current.status = state::expanding;
+        if (meter_ != nullptr) {
+            meter_->check_time();
+        }
+        std::string expanded;
+        expanded.reserve(value.data.size());
+        size_t height = 0;
+        auto resolve_name = [this, &key, &height, depth](std::string_view name,
+                                                         size_t next_depth) {
+            entry_height_.reset();
+            auto resolved = resolve(name, key, next_depth);
+            if (entry_height_) {
+                height = std::max(height, next_depth - depth + *entry_height_);
+            }
+            // O crescimento é cobrado antes de ser copiado para `expanded`
+            if (resolved && meter_ != nullptr) {
+                meter_->charge_memory(resolved->size());
+            }
+            return resolved;
+        };
+        expand_text(value.data, expanded, depth + 1, resolve_name);
+        value.data = std::move(expanded);
+        current = {.status = state::done, .height = height};
+        entry_height_ = height;
+        return std::string_view(value.data);
+    }
+
+    auto resolve(std::string_view name, std::string_view self, size_t depth)
+        -> std::optional<std::string_view> {
+        // Auto-referência (PATH=${PATH}:...) usa o valor anterior
+        if (name != self) {
+            auto it = entries_.find(name);
+            if (it != entries_.end()) {
+                return resolve_entry(it->first, it->second, depth);
+            }
+        }
+
+        auto it = external_.find(name);
+        if (it == external_.end()) {
+            it = external_.emplace(std::string(name), lookup_(name)).first;
+        }
+        if (!it->second) {
+            return std::nullopt;
+        }
+        return std::string_view(*it->second);
+    }
+
+    env_map &entries_;
+    const key_set &literal_keys_;
+    const external_lookup &lookup_;
+    budget_meter *meter_;
+    // Chaves apontam para as chaves de entries_, estáveis durante a expansão
+    std::unordered_map<std::string_view, node> states_;
+    // Altura da última entrada do arquivo resolvida; vazia para consultas
+    // externas e referências cíclicas
+    std::optional<size_t> entry_height_;
+    // Consultas externas memorizadas (inclusive as que não encontraram nada)
+    std::unordered_map<std::string, std::optional<std::string>, string_hash,
+                       std::equal_to<>>
+        external_;
+    size_t cycles_{0};
+};
+
+// Expansão sob demanda de valores adiados; memoriza em `memo` cada valor
+// adiado expandido, inclusive os alcançados por referência
+class deferred_expander {
+  public:
+    deferred_expander(const entry_lookup &entries,
+                      const external_lookup &external, expansion_memo &memo,
+                      const dotenv::detail::dependency_sink *on_dependency)
+        : entries_(entries), external_(external), memo_(memo),
+          on_dependency_(on_dependency) {}
+
+    auto expand(std::string_view key, std::string_view raw, size_t depth)
+        -> const std::string & {
+        const std::string self(key);
+        expanding_.push_back(self);
+        std::string expanded;
+        expanded.reserve(raw.size());
+        auto resolve_name = [this, &self](std::string_view name,
+                                          size_t next_depth) {
+            return resolve(name, self, next_depth);
+        };
+        expand_text(raw, expanded, depth + 1, resolve_name);
+        expanding_.pop_back();
+        return memo_.insert_or_assign(std::string(key), std::move(expanded))
+            .first->second;
+    }
+
+  private:
+    auto resolve(std::string_view name, std::string_view dependent,
+                 size_t depth) -> std::optional<std::string> {
+        if (on_dependency_ != nullptr) {
+            (*on_dependency_)(name, dependent);
+        }
+        if (name == dependent) {
+            // Auto-referências já foram fixadas na carga; sobra o ambiente
+            return external_(name);
+        }
+        if (auto it = memo_.find(name); it != memo_.end()) {
+            return it->second;
+        }
+        for (const auto &active : expanding_) {
+            if (active == name) {
+                return std::nullopt;
+            }
+        }
+        if (depth > max_expansion_depth) {
+            return std::nullopt;
+        }
+
+        auto entry = entries_(name);
+        if (!entry) {
+            return external_(name);
+        }
+        if (!entry->deferred) {
+            return std::move(entry->data);
+        }
+        return expand(name, entry->data, depth);
+    }
+
+    const entry_lookup &entries_;
+    const external_lookup &external_;
+    expansion_memo &memo_;
+    const dotenv::detail::dependency_sink *on_dependency_;
+    // Pilha de chaves em expansão, para detectar ciclos
+    std::vector<std::string> expanding_;
+};
+
+// Escapa '$' para que o texto continue literal dentro de um template
+void append_escaped(std::string_view text, std::string &out) {
+    for (const char chr : text) {
+        if (chr == '$') {
+            out += '\\';
+        }
+        out += chr;
+    }
+}
+
+} // namespace
+
+auto dotenv::detail::interpolate_entries(env_map &entries,
+                                         const key_set &literal_keys,
+                                         const external_lookup &lookup,
+                                         budget_meter *meter) -> size_t {
+    interpolator pass(entries, literal_keys, lookup, meter);
+    pass.run();
+    return pass.cycles();
+}
+
+auto dotenv::detail::needs_expansion(std::string_view raw) noexcept -> bool {
+    return raw.find('$') != std::string_view::npos;
+}
+
+auto dotenv::detail::bind_self_references(
+    std::string_view key, std::string_view raw,
+    const std::optional<std::string> &previous) -> std::string {
+    std::string bound;
+    bound.reserve(raw.size());
+    size_t pos = 0;
+    while (pos < raw.size()) {
+        const auto special = raw.find_first_of("$\\", pos);
+        if (special == std::string_view::npos) {
+            bound.append(raw.substr(pos));
+            break;
+        }
+        bound.append(raw.substr(pos, special - pos));
+        pos = special;
+
+        if (raw[pos] == '\\') {
+            // Escapes passam intactos para a expansão posterior
+            const auto length = std::min<size_t>(2, raw.size() - pos);
+            bound.append(raw.substr(pos, length));
+            pos += length;
+            continue;
+        }
+
+        const auto ref = parse_reference(raw, pos);
+        if (ref.name != key) {
+            bound.append(raw.substr(pos, ref.end - pos));
+        } else if (previous && !(ref.has_default && previous->empty())) {
+            append_escaped(*previous, bound);
+        } else if (ref.has_default) {
+            bound.append(ref.fallback);
+        }
+        pos = ref.end;
+    }
+    return bound;
+}
+
+auto dotenv::detail::expand_deferred(std::string_view key,
+                                     std::string_view raw,
+                                     const entry_lookup &entries,
+                                     const external_lookup &external,
+                                     expansion_memo &memo,
+                                     const dependency_sink *on_dependency)
+    -> const std::string & {
+    deferred_expander expander(entries, external, memo, on_dependency);
+    return expander.expand(key, raw, 0);
+}
+
+void dotenv::detail::expansion_cache::invalidate(std::string_view key) {
+    if (!enabled_.load(std::memory_order_seq_cst)) {
+        return;
+    }
+
+    std::lock_guard lock(mutex_);
+    std::vector<std::string> pending{std::string(key)};
+    while (!pending.empty()) {
+        auto current = std::move(pending.back());
+        pending.pop_back();
+
+        if (auto it = values_.find(current); it != values_.end()) {
+            values_.erase(it);
+        }
+        // Remover a lista antes de percorrê-la encerra ciclos de dependência
+        auto node = dependents_.extract(current);
+        if (!node.empty()) {
+            pending.insert(pending.end(),
+                           std::make_move_iterator(node.mapped().begin()),
+                           std::make_move_iterator(node.mapped().end()));
+        }
+    }
+}
+
+void dotenv::detail::expansion_cache::clear() {
+    std::lock_guard lock(mutex_);
+    values_.clear();
+    dependents_.clear();
+}
+
+auto dotenv::detail::expansion_cache::resolve(std::string_view key,
+                                              const entry_lookup &entries,
+                                              const external_lookup &external)
+    -> const std::string * {
+    if (auto it = values_.find(key); it != values_.end()) {
+        return &it->second;
+    }
+
+    auto entry = entries(key);
+    if (!entry) {
+        return nullptr;
+    }
+    if (!entry->deferred) {
+        // Valor sobrescrito depois da leitura de quem chamou; quem o
+        // sobrescreveu invalida esta entrada em seguida
+        auto stored =
+            values_.insert_or_assign(std::string(key), std::move(entry->data));
+        return &stored.first->second;
+    }
+
+    const dependency_sink record = [this](std::string_view dependency,
+                                          std::string_view dependent) {
+        auto it = dependents_.find(dependency);
+        if (it == dependents_.end()) {
+            it = dependents_.emplace(std::string(dependency), key_set{})
+                     .first;
+        }
+        it->second.emplace(dependent);
+    };
+    return &expand_deferred(key, entry->data, entries, external, values_,
+                            &record);
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "dotenv_budget.hpp"
+#include "dotenv_store.hpp"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Expansão de referências ${VAR}, $VAR e ${VAR:-default}. Cabeçalho interno.
+namespace dotenv::detail {
+
+// Lançada pela expansão eager quando uma cadeia de referências passa do
+// limite de aninhamento; é um budget_exceeded para que toda carga a trate
+// como dotenv_error::limit_exceeded, sem commit parcial
+struct expansion_too_deep : budget_exceeded {};
+
+// Valor de uma referência fora das entradas em expansão (store, ambiente)
+using external_lookup =
+    std::function<std::optional<std::string>(std::string_view name)>;
+
+// Cópia da entrada armazenada de uma chave (nullopt se ausente)
+using entry_lookup =
+    std::function<std::optional<ValueStruct>(std::string_view name)>;
+
+// Chamado para cada referência lida durante uma expansão adiada
+using dependency_sink =
+    std::function<void(std::string_view dependency, std::string_view key)>;
+
+/**
+ * @brief Expande as referências de todas as entradas, no lugar
+ *
+ * As entradas formam um grafo de dependências percorrido em profundidade com
+ * memoização: cada valor é expandido uma única vez, e consultas externas
+ * também são memorizadas. Referências dentro de um ciclo são tratadas como
+ * não definidas; cadeias com mais de 256 referências aninhadas lançam
+ * expansion_too_deep. Valores de `literal_keys` não são expandidos. Com
+ * `meter`, cada valor inserido por uma referência é descontado do orçamento de
+ * memória (budget_exceeded interrompe a expansão no meio).
+ *
+ * @return Número de referências cíclicas encontradas
+ */
+auto interpolate_entries(env_map &entries, const key_set &literal_keys,
+                         const external_lookup &lookup,
+                         budget_meter *meter = nullptr) -> size_t;
+
+// true se o valor tem algo a expandir (caso contrário fica literal)
+auto needs_expansion(std::string_view raw) noexcept -> bool;
+
+/**
+ * @brief Troca as auto-referências de `key` em `raw` pelo valor anterior
+ *
+ * Na expansão adiada o valor anterior já foi sobrescrito quando o template é
+ * lido, então ele é fixado na carga, escapado para continuar literal. Demais
+ * referências ficam intactas.
+ */
+auto bind_self_references(std::string_view key, std::string_view raw,
+                          const std::optional<std::string> &previous)
+    -> std::string;
+
+/**
+ * @brief Expande o template adiado `raw` da chave `key`
+ *
+ * Referências a outros valores adiados são expandidas recursivamente; cada
+ * valor adiado expandido fica em `memo`. Chaves ausentes de `entries` vão para
+ * `external`. Ciclos são tratados como não definidos.
+ *
+ * @return Valor expandido, guardado em memo[key]
+ */
+auto expand_deferred(std::string_view key, std::string_view raw,
+                     const entry_lookup &entries,
+                     const external_lookup &external, expansion_memo &memo,
+                     const dependency_sink *on_dependency = nullptr)
+    -> const std::string &;
+
+/**
+ * @brief Expansões dos valores adiados do store, calculadas no primeiro acesso
+ *
+ * Cada expansão registra as chaves que leu; invalidate(chave) descarta a
+ * expansão da chave e, transitivamente, a de quem depende dela. Ordem de
+ * locks: cache, depois shards do store; escritores invalidam depois de
+ * liberar os shards.
+ */
+class expansion_cache {
+  public:
+    // fn(const std::string *) sob o lock do cache com o valor de `key`
+    // (expandido se adiado; nullptr se ausente do store)
+    template <class Fn>
+    auto with_value(std::string_view key, const entry_lookup &entries,
+                    const external_lookup &external, Fn &&fn) {
+        std::lock_guard lock(mutex_);
+        return std::forward<Fn>(fn)(resolve(key, entries, external));
+    }
+
+    // Chamado antes de o store receber o primeiro valor adiado; até lá
+    // invalidate() retorna sem travar nada
+    void enable() noexcept { enabled_.store(true, std::memory_order_seq_cst); }
+
+    void invalidate(std::string_view key);
+    void clear();
+
+  private:
+    auto resolve(std::string_view key, const entry_lookup &entries,
+                 const external_lookup &external) -> const std::string *;
+
+    std::mutex mutex_;
+    std::atomic<bool> enabled_{false};
+    expansion_memo values_;
+    // Chave lida -> chaves cujas expansões a leram
+    std::unordered_map<std::string, key_set, string_hash, std::equal_to<>>
+        dependents_;
+};
+
+} // namespace dotenv::detail
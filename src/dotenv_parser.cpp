@@ -0,0 +1,336 @@
+#include "dotenv_parser.hpp"
+#include "dotenv_budget.hpp"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <utility>
+
+namespace {
+
+using dotenv::detail::MAX_KEY_LENGTH;
+using dotenv::detail::MAX_LINE_LENGTH;
+using dotenv::detail::MAX_VALUE_LENGTH;
+
+// Limites padrão como constantes, para que o caso comum compare com
+// valores imediatos
+struct default_bounds {
+    static constexpr auto line() noexcept -> size_t { return MAX_LINE_LENGTH; }
+    static constexpr auto key() noexcept -> size_t { return MAX_KEY_LENGTH; }
+    static constexpr auto value() noexcept -> size_t {
+        return MAX_VALUE_LENGTH;
+    }
+    static constexpr auto entries() noexcept -> size_t {
+        return std::numeric_limits<size_t>::max();
+    }
+    static constexpr void charge_lines(size_t /*count*/) noexcept {}
+    static constexpr void charge_entry(size_t /*bytes*/) noexcept {}
+};
+
+// Limites configurados em load_options::limits e orçamento opcional
+struct runtime_bounds {
+    const dotenv::parse_limits &limits;
+    dotenv::detail::budget_meter *meter;
+
+    auto line() const noexcept -> size_t { return limits.max_line_length; }
+    auto key() const noexcept -> size_t { return limits.max_key_length; }
+    auto value() const noexcept -> size_t { return limits.max_value_length; }
+    auto entries() const noexcept -> size_t { return limits.max_entries; }
+    void charge_lines(size_t count) const {
+        if (meter != nullptr) {
+            meter->charge_lines(count);
+        }
+    }
+    void charge_entry(size_t bytes) const {
+        if (meter != nullptr) {
+            meter->charge_memory(bytes);
+        }
+    }
+};
+
+constexpr auto is_blank(char chr) noexcept -> bool {
+    return chr == ' ' || chr == '\t';
+}
+
+// Remove espaços em branco no início e fim
+auto trim(std::string_view str) noexcept -> std::string_view {
+    const auto start = str.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) {
+        return {};
+    }
+    const auto end = str.find_last_not_of(" \t\r\n");
+    return str.substr(start, end - start + 1);
+}
+
+// Validação de chave (deve ser um identificador válido)
+auto is_valid_key(std::string_view key, size_t max_length) noexcept -> bool {
+    if (key.empty() || key.size() > max_length) {
+        return false;
+    }
+
+    // Primeira char deve ser letra ou underscore
+    if ((std::isalpha(static_cast<unsigned char>(key[0])) == 0) &&
+        key[0] != '_') {
+        return false;
+    }
+
+    // Restante deve ser alfanumérico ou underscore
+    return std::all_of(key.begin() + 1, key.end(), [](char chr) {
+        return std::isalnum(static_cast<unsigned char>(chr)) != 0 ||
+               chr == '_';
+    });
+}
+
+// "export KEY=value" é tratado como "KEY=value"
+auto strip_export(std::string_view text) noexcept -> std::string_view {
+    constexpr std::string_view prefix = "export";
+    if (text.size() <= prefix.size() || !text.starts_with(prefix) ||
+        !is_blank(text[prefix.size()])) {
+        return text;
+    }
+    text.remove_prefix(prefix.size());
+    while (!text.empty() && is_blank(text.front())) {
+        text.remove_prefix(1);
+    }
+    return text;
+}
+
+// Posição das aspas que fecham as abertas em content[open]; podem estar em
+// outra linha. npos se não fecharem.
+auto closing_quote(std::string_view content, size_t open) noexcept -> size_t {
+    if (content[open] == '\'') {
+        return content.find('\'', open + 1);
+    }
+
+    size_t pos = open + 1;
+    while (pos < content.size()) {
+        pos = content.find_first_of("\"\\", pos);
+        if (pos == std::string_view::npos || content[pos] == '"') {
+            return pos;
+        }
+        pos += 2; // Pula o caractere escapado
+    }
+    return std::string_view::npos;
+}
+
+// Conteúdo entre aspas: escapes só em aspas duplas; CRLF vira LF
+auto unquote(std::string_view raw, char quote) -> std::string {
+    std::string result;
+    result.reserve(raw.size());
+
+    for (size_t i = 0; i < raw.size(); ++i) {
+        const char chr = raw[i];
+        if (chr == '\r' && i + 1 < raw.size() && raw[i + 1] == '\n') {
+            continue;
+        }
+        if (quote != '"' || chr != '\\' || i + 1 == raw.size()) {
+            result += chr;
+            continue;
+        }
+
+        const char next = raw[++i];
+        switch (next) {
+        case 'n':
+            result += '\n';
+            break;
+        case 't':
+            result += '\t';
+            break;
+        case 'r':
+            result += '\r';
+            break;
+        case '\\':
+            result += '\\';
+            break;
+        case '"':
+            result += '"';
+            break;
+        default:
+            result += '\\';
+            result += next;
+            break;
+        }
+    }
+
+    return result;
+}
+
+// Valor sem aspas: até o fim da linha, sem comentário inline. `text` começa
+// logo após o '=', então "KEY=#abc" mantém o '#'.
+auto unquoted_value(std::string_view text) noexcept -> std::string_view {
+    for (size_t i = 1; i < text.size(); ++i) {
+        if (text[i] == '#' && is_blank(text[i - 1])) {
+            text = text.substr(0, i);
+            break;
+        }
+    }
+    return trim(text);
+}
+
+} // namespace
+
+auto dotenv::detail::find_newline(std::string_view content,
+                                  size_t from) noexcept -> size_t {
+    return content.find('\n', from);
+}
+
+namespace {
+
+// Laço do parser; `Bounds` fornece os limites (constantes em default_bounds)
+template <typename Bounds>
+auto parse_with(std::string_view content,
+                const dotenv::detail::entry_callback &on_entry,
+                dotenv::detail::newline_finder next_newline,
+                const dotenv::detail::issue_callback &on_issue,
+                dotenv::detail::parse_stats *stats, const Bounds &bounds)
+    -> int {
+    int count = 0;
+    size_t line = 1;
+    // Contados localmente e copiados no final
+    dotenv::detail::parse_stats counted;
+
+    for (size_t pos = 0; pos < content.size(); ++line) {
+        size_t eol = next_newline(content, pos);
+        if (eol == std::string_view::npos) {
+            eol = content.size();
+        }
+        const auto physical = content.substr(pos, eol - pos);
+        const size_t entry_line = line;
+        bounds.charge_lines(1);
+
+        // Estado inicial: a próxima linha começa depois do fim desta, a menos
+        // que um valor entre aspas atravesse linhas
+        const auto advance = [&]() { pos = eol + 1; };
+        // Coluna (a partir de 1) de uma posição de content nesta linha
+        const auto column = [&](size_t at) { return at - pos + 1; };
+
+        if (physical.size() > bounds.line()) {
+            ++counted.long_lines;
+            if (on_issue) {
+                on_issue(line, bounds.line() + 1,
+                         dotenv::diagnostic_code::line_too_long);
+            }
+            advance();
+            continue;
+        }
+
+        // Estado: chave (comentários, linhas vazias e "export")
+        const auto text = strip_export(trim(physical));
+        if (text.empty() || text[0] == '#') {
+            ++counted.skipped;
+            advance();
+            continue;
+        }
+        const auto eq_pos = text.find('=');
+        const auto key = trim(text.substr(0, eq_pos));
+        if (eq_pos == std::string_view::npos ||
+            !is_valid_key(key, bounds.key())) {
+            ++counted.rejected;
+            if (on_issue) {
+                // A chave começa no início do texto aparado
+                on_issue(line,
+                         column(static_cast<size_t>(text.data() -
+                                                    content.data())),
+                         (eq_pos == std::string_view::npos)
+                             ? dotenv::diagnostic_code::missing_separator
+                             : dotenv::diagnostic_code::invalid_key);
+            }
+            advance();
+            continue;
+        }
+
+        if (static_cast<size_t>(count) == bounds.entries()) {
+            // O restante do arquivo não é analisado
+            if (on_issue) {
+                on_issue(line,
+                         column(static_cast<size_t>(text.data() -
+                                                    content.data())),
+                         dotenv::diagnostic_code::too_many_entries);
+            }
+            ++line;
+            break;
+        }
+
+        // Estado: início do valor
+        auto value_pos =
+            static_cast<size_t>(text.data() - content.data()) + eq_pos + 1;
+        while (value_pos < eol && is_blank(content[value_pos])) {
+            ++value_pos;
+        }
+
+        dotenv::detail::parsed_entry entry{
+            .key = key, .line = entry_line, .offset = pos};
+        bool quoted = false;
+        if (value_pos < eol &&
+            (content[value_pos] == '"' || content[value_pos] == '\'')) {
+            // Estado: valor entre aspas, possivelmente multilinha
+            const auto close = closing_quote(content, value_pos);
+            if (close != std::string_view::npos) {
+                const char quote = content[value_pos];
+                entry.value = unquote(
+                    content.substr(value_pos + 1, close - value_pos - 1),
+                    quote);
+                entry.single_quoted = (quote == '\'');
+                quoted = true;
+
+                if (close > eol) {
+                    const auto crossed = content.substr(eol, close - eol);
+                    const auto extra = static_cast<size_t>(
+                        std::count(crossed.begin(), crossed.end(), '\n'));
+                    line += extra;
+                    bounds.charge_lines(extra);
+                    eol = next_newline(content, close + 1);
+                    if (eol == std::string_view::npos) {
+                        eol = content.size();
+                    }
+                }
+                // O restante da linha após as aspas (comentário) é ignorado
+            }
+        }
+        if (!quoted) {
+            // Estado: valor sem aspas até o fim da linha
+            entry.value = std::string(
+                unquoted_value(content.substr(value_pos, eol - value_pos)));
+        }
+
+        if (entry.value.size() > bounds.value()) {
+            entry.value.resize(bounds.value());
+            ++counted.truncated_values;
+            if (on_issue) {
+                on_issue(entry_line, column(value_pos),
+                         dotenv::diagnostic_code::value_truncated);
+            }
+        }
+
+        bounds.charge_entry(entry.key.size() + entry.value.size());
+        entry.end = std::min(eol + 1, content.size());
+        ++count;
+        on_entry(std::move(entry));
+        advance();
+    }
+
+    if (stats != nullptr) {
+        counted.lines = line - 1;
+        *stats = counted;
+    }
+    return count;
+}
+
+} // namespace
+
+auto dotenv::detail::parse_content(std::string_view content,
+                                   const entry_callback &on_entry,
+                                   newline_finder next_newline,
+                                   const issue_callback &on_issue,
+                                   parse_stats *stats,
+                                   const parse_limits &limits,
+                                   budget_meter *meter) -> int {
+    // max_file_size não afeta o laço
+    auto bounded = limits;
+    bounded.max_file_size = parse_limits{}.max_file_size;
+    if (bounded == parse_limits{} && meter == nullptr) {
+        return parse_with(content, on_entry, next_newline, on_issue, stats,
+                          default_bounds{});
+    }
+    return parse_with(content, on_entry, next_newline, on_issue, stats,
+                      runtime_bounds{limits, meter});
+}
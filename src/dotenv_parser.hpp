@@ -0,0 +1,84 @@
+#pragma once
+
+#include "dotenv_types.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace dotenv::detail {
+class budget_meter; // dotenv_budget.hpp
+} // namespace dotenv::detail
+
+// Parser de conteúdo .env compartilhado pelos backends tradicional e SIMD.
+// Cabeçalho interno, não instalado.
+namespace dotenv::detail {
+
+// Limites de segurança padrão (parse_limits{}) para evitar DoS
+inline constexpr size_t MAX_LINE_LENGTH = parse_limits{}.max_line_length;
+inline constexpr size_t MAX_KEY_LENGTH = parse_limits{}.max_key_length;
+inline constexpr size_t MAX_VALUE_LENGTH = parse_limits{}.max_value_length;
+
+// Uma definição KEY=valor encontrada no conteúdo
+struct parsed_entry {
+    std::string_view key; // aponta para o conteúdo analisado
+    std::string value{};
+    bool single_quoted{false};
+    size_t line{0}; // linha (a partir de 1) onde a definição começa
+    // Bytes [offset, end) do conteúdo ocupados pela definição, das linhas
+    // inteiras, incluindo o '\n' final
+    size_t offset{0};
+    size_t end{0};
+};
+
+// Posição do próximo '\n' em content a partir de `from` (npos se não houver)
+using newline_finder = size_t (*)(std::string_view content,
+                                  size_t from) noexcept;
+
+auto find_newline(std::string_view content, size_t from) noexcept -> size_t;
+
+// Contadores de uma análise, por linha física
+struct parse_stats {
+    size_t lines{};            // linhas percorridas
+    size_t skipped{};          // vazias e comentários
+    size_t rejected{};         // sem '=' ou com chave inválida
+    size_t long_lines{};       // acima de MAX_LINE_LENGTH, ignoradas
+    size_t truncated_values{}; // valores cortados em MAX_VALUE_LENGTH
+};
+
+using entry_callback = std::function<void(parsed_entry &&entry)>;
+// Chamado para cada linha ignorada ou alterada: linha e coluna (a partir de
+// 1) e o motivo
+using issue_callback =
+    std::function<void(size_t line, size_t column, diagnostic_code code)>;
+
+/**
+ * @brief Analisa o conteúdo inteiro de um arquivo .env
+ *
+ * Máquina de estados sobre o conteúdo, não sobre linhas isoladas:
+ * - `export KEY=value` é aceito como `KEY=value`;
+ * - valores entre aspas duplas ou simples podem ocupar várias linhas (CRLF
+ *   dentro das aspas vira LF); aspas duplas processam \n \t \r \\ \";
+ * - fora das aspas, '#' precedido de espaço inicia um comentário;
+ * - aspas sem fechamento valem só até o fim da linha, como valor sem aspas.
+ *
+ * `next_newline` só muda a busca de fim de linha (o backend SIMD usa AVX2);
+ * o resultado é o mesmo para qualquer implementação.
+ *
+ * `on_issue`, se não vazio, é chamado só nos caminhos de rejeição, e `stats`,
+ * se fornecido, recebe os contadores da análise. Com os limites padrão, o
+ * laço é especializado para limites constantes; outros valores de `limits`
+ * são lidos em tempo de execução. max_file_size fica a cargo de quem chama.
+ * Com `meter`, linhas e bytes das entradas são descontados do orçamento, e
+ * budget_exceeded é lançada quando ele se esgota.
+ *
+ * @return Número de definições válidas
+ */
+auto parse_content(std::string_view content, const entry_callback &on_entry,
+                   newline_finder next_newline = find_newline,
+                   const issue_callback &on_issue = {},
+                   parse_stats *stats = nullptr,
+                   const parse_limits &limits = {},
+                   budget_meter *meter = nullptr) -> int;
+
+} // namespace dotenv::detail
@@ -0,0 +1,446 @@
+#include "dotenv.hpp"
+#include "dotenv_image.hpp"
+#include "dotenv_store.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+
+// Segmento: segment_header, depois a imagem de dotenv_image.hpp a partir de
+// image_offset. Só offsets relativos, então cada processo pode mapear o
+// segmento em qualquer endereço.
+namespace {
+
+constexpr std::array<char, 8> segment_magic = {'D', 'O', 'T', 'E',
+                                               'N', 'V', 'S', 'H'};
+constexpr std::uint32_t segment_version = 1;
+constexpr size_t image_offset = 64;
+constexpr size_t minimum_capacity = 64 * 1024;
+// Limites de espera de um leitor por uma publicação: um publicador que morre
+// entre os dois incrementos deixa a sequência ímpar até o próximo publish
+constexpr unsigned max_read_attempts = 1U << 16;
+constexpr auto max_read_wait = std::chrono::milliseconds(250);
+
+struct segment_header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t reserved;
+    // Seqlock: ímpar enquanto uma publicação reescreve a imagem
+    std::uint64_t sequence;
+    std::uint64_t capacity; // Fixo desde a criação
+    std::uint64_t image_size;
+};
+
+static_assert(sizeof(segment_header) <= image_offset);
+// Processos diferentes só se sincronizam por atômicos sem lock
+static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free);
+
+// Campos lidos e escritos por vários processos ao mesmo tempo
+auto shared_word(const std::uint64_t &field) noexcept
+    -> std::atomic_ref<std::uint64_t> {
+    // Só loads são feitos pelos leitores, cujo mapeamento é somente leitura
+    return std::atomic_ref<std::uint64_t>(
+        const_cast<std::uint64_t &>(field)); // NOLINT
+}
+
+// shm_open exige um nome "/nome" sem outras barras
+auto segment_name(std::string_view name) -> std::optional<std::string> {
+    std::string normalized(name);
+    if (!normalized.starts_with('/')) {
+        normalized.insert(normalized.begin(), '/');
+    }
+    if (normalized.size() < 2 ||
+        normalized.find('/', 1) != std::string::npos) {
+        return std::nullopt;
+    }
+    return normalized;
+}
+
+// Descritor e mapeamento com liberação automática
+class mapping {
+  public:
+    mapping() noexcept = default;
+    ~mapping() noexcept { reset(); }
+
+    mapping(const mapping &) = delete;
+    auto operator=(const mapping &) -> mapping & = delete;
+
+    auto map(int fd, size_t size, int protection) noexcept -> bool {
+        reset();
+        void *data = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        data_ = data;
+        size_ = size;
+        return true;
+    }
+
+    void reset() noexcept {
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    [[nodiscard]] auto bytes() const noexcept -> char * {
+        return static_cast<char *>(data_);
+    }
+    [[nodiscard]] auto size() const noexcept -> size_t { return size_; }
+    [[nodiscard]] auto header() const noexcept -> segment_header * {
+        return static_cast<segment_header *>(data_);
+    }
+
+  private:
+    void *data_{};
+    size_t size_{};
+};
+
+class file_descriptor {
+  public:
+    explicit file_descriptor(int fd) noexcept : fd_(fd) {}
+    ~file_descriptor() noexcept {
+        if (fd_ != -1) {
+            ::close(fd_); // Também libera o flock
+        }
+    }
+
+    file_descriptor(const file_descriptor &) = delete;
+    auto operator=(const file_descriptor &) -> file_descriptor & = delete;
+
+    [[nodiscard]] auto get() const noexcept -> int { return fd_; }
+
+  private:
+    int fd_;
+};
+
+// Imagem do estado atual do store, com valores adiados expandidos
+auto current_image() -> std::optional<std::string> {
+    auto [table, generation] = dotenv::detail::global_store().pin();
+    dotenv::detail::image::entry_list entries;
+    entries.reserve(table->size());
+    table->for_each([&](const std::string &key,
+                        const dotenv::detail::ValueStruct &value) {
+        // Válidos enquanto a tabela estiver fixada
+        entries.emplace_back(key,
+                             dotenv::detail::pinned_value(*table, key, value));
+    });
+    return dotenv::detail::image::build(entries, generation);
+}
+
+} // namespace
+
+struct dotenv::shared_env::segment {
+    mapping memory;
+
+    [[nodiscard]] auto header() const noexcept -> const segment_header & {
+        return *memory.header();
+    }
+
+    // fn(const layout *) com a última publicação completa; o layout é nullptr
+    // se a imagem lida não confere. fn deve copiar o que precisar: o
+    // resultado só é aceito se a sequência não mudou durante a leitura.
+    // Lança std::system_error(timed_out) se nenhuma leitura estável for
+    // possível dentro de max_read_attempts/max_read_wait.
+    template <class Fn> auto read(Fn &&fn) const {
+        const auto &fields = header();
+        const std::string_view image(memory.bytes() + image_offset,
+                                     fields.capacity);
+        const auto deadline = std::chrono::steady_clock::now() + max_read_wait;
+        for (unsigned attempt = 0; attempt < max_read_attempts; ++attempt) {
+            const auto before =
+                shared_word(fields.sequence).load(std::memory_order_acquire);
+            if ((before & 1U) != 0) {
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto size = std::min<std::uint64_t>(
+                shared_word(fields.image_size).load(std::memory_order_relaxed),
+                fields.capacity);
+            const auto layout =
+                detail::image::parse_layout(image.substr(0, size));
+            auto result = fn(layout ? &*layout : nullptr);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (shared_word(fields.sequence)
+                    .load(std::memory_order_relaxed) == before) {
+                return result;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+        }
+        throw std::system_error(
+            std::make_error_code(std::errc::timed_out),
+            "dotenv::shared_env: segment stuck in an unfinished publication");
+    }
+};
+
+auto dotenv::publish_shared(std::string_view name, size_t capacity,
+                            unsigned int mode) noexcept -> dotenv_error {
+    try {
+        const auto shm_name = segment_name(name);
+        if (!shm_name) {
+            return dotenv_error::invalid_argument;
+        }
+        auto image = current_image();
+        if (!image) {
+            return dotenv_error::buffer_too_small;
+        }
+
+        const file_descriptor fd(
+            ::shm_open(shm_name->c_str(), O_RDWR | O_CREAT | O_CLOEXEC,
+                       static_cast<mode_t>(mode)));
+        if (fd.get() == -1) {
+            return dotenv_error::permission_denied;
+        }
+        // Um publicador por vez; também espera a inicialização do criador
+        while (::flock(fd.get(), LOCK_EX) != 0) {
+            if (errno != EINTR) {
+                return dotenv_error::permission_denied;
+            }
+        }
+
+        struct stat info {};
+        if (::fstat(fd.get(), &info) != 0) {
+            return dotenv_error::permission_denied;
+        }
+
+        mapping memory;
+        if (info.st_size == 0) {
+            // Segmento novo: a capacidade fica fixa, leitores mapeiam tudo
+            if (capacity == 0) {
+                capacity = std::max(minimum_capacity,
+                                    std::bit_ceil(image->size() * 2));
+            }
+            const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            const auto total =
+                (image_offset + capacity + page - 1) / page * page;
+            if (::ftruncate(fd.get(), static_cast<off_t>(total)) != 0 ||
+                !memory.map(fd.get(), total, PROT_READ | PROT_WRITE)) {
+                return dotenv_error::out_of_memory;
+            }
+            auto *fields = memory.header();
+            fields->magic = segment_magic;
+            fields->version = segment_version;
+            fields->capacity = total - image_offset;
+        } else {
+            const auto total = static_cast<size_t>(info.st_size);
+            if (total < image_offset ||
+                !memory.map(fd.get(), total, PROT_READ | PROT_WRITE)) {
+                return dotenv_error::invalid_format;
+            }
+            const auto *fields = memory.header();
+            if (fields->magic != segment_magic ||
+                fields->version != segment_version ||
+                fields->capacity > total - image_offset) {
+                return dotenv_error::invalid_format;
+            }
+        }
+
+        auto *fields = memory.header();
+        if (image->size() > fields->capacity) {
+            return dotenv_error::buffer_too_small;
+        }
+
+        // Seqlock: ímpar, reescreve, par. Uma sequência ímpar deixada por um
+        // publicador que morreu no meio é corrigida aqui.
+        auto sequence = shared_word(fields->sequence);
+        auto start = sequence.load(std::memory_order_relaxed);
+        start += (start & 1U);
+        sequence.store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(memory.bytes() + image_offset, image->data(),
+                    image->size());
+        shared_word(fields->image_size)
+            .store(image->size(), std::memory_order_relaxed);
+        sequence.store(start + 2, std::memory_order_release);
+        return dotenv_error::success;
+    } catch (const std::exception &) {
+        return dotenv_error::out_of_memory;
+    }
+}
+
+auto dotenv::unlink_shared(std::string_view name) noexcept -> dotenv_error {
+    try {
+        const auto shm_name = segment_name(name);
+        if (!shm_name) {
+            return dotenv_error::invalid_argument;
+        }
+        if (::shm_unlink(shm_name->c_str()) != 0) {
+            return (errno == ENOENT) ? dotenv_error::file_not_found
+                                     : dotenv_error::permission_denied;
+        }
+        return dotenv_error::success;
+    } catch (const std::exception &) {
+        return dotenv_error::out_of_memory;
+    }
+}
+
+auto dotenv::attach_shared(std::string_view name) noexcept
+    -> std::pair<dotenv_error, shared_env> {
+    try {
+        const auto shm_name = segment_name(name);
+        if (!shm_name) {
+            return {dotenv_error::invalid_argument, {}};
+        }
+
+        const file_descriptor fd(
+            ::shm_open(shm_name->c_str(), O_RDONLY | O_CLOEXEC, 0));
+        if (fd.get() == -1) {
+            return {(errno == ENOENT) ? dotenv_error::file_not_found
+                                      : dotenv_error::permission_denied,
+                    {}};
+        }
+        struct stat info {};
+        if (::fstat(fd.get(), &info) != 0) {
+            return {dotenv_error::permission_denied, {}};
+        }
+        const auto total = static_cast<size_t>(info.st_size);
+        if (total < image_offset) {
+            return {dotenv_error::file_not_found, {}}; // Ainda sendo criado
+        }
+
+        auto attached = std::make_shared<shared_env::segment>();
+        if (!attached->memory.map(fd.get(), total, PROT_READ)) {
+            return {dotenv_error::permission_denied, {}};
+        }
+        const auto &fields = attached->header();
+        // Antes da primeira publicação o cabeçalho pode estar incompleto
+        if (shared_word(fields.sequence).load(std::memory_order_acquire) < 2) {
+            return {dotenv_error::file_not_found, {}};
+        }
+        if (fields.magic != segment_magic ||
+            fields.version != segment_version ||
+            fields.capacity > total - image_offset) {
+            return {dotenv_error::invalid_format, {}};
+        }
+
+        shared_env env;
+        env.segment_ = std::move(attached);
+        return {dotenv_error::success, std::move(env)};
+    } catch (const std::exception &) {
+        return {dotenv_error::out_of_memory, {}};
+    }
+}
+
+auto dotenv::shared_env::find(std::string_view key) const
+    -> std::optional<std::string> {
+    if (!segment_) {
+        return std::nullopt;
+    }
+    return segment_->read(
+        [key](const detail::image::layout *layout)
+            -> std::optional<std::string> {
+            if (layout == nullptr) {
+                return std::nullopt;
+            }
+            auto value = detail::image::find(*layout, key);
+            if (!value) {
+                return std::nullopt;
+            }
+            return std::string(*value);
+        });
+}
+
+auto dotenv::shared_env::get(std::string_view key,
+                             std::string_view default_value) const
+    -> std::string {
+    auto value = find(key);
+    return value ? std::move(*value) : std::string(default_value);
+}
+
+auto dotenv::shared_env::contains(std::string_view key) const -> bool {
+    if (!segment_) {
+        return false;
+    }
+    return segment_->read([key](const detail::image::layout *layout) {
+        return layout != nullptr && detail::image::find(*layout, key);
+    });
+}
+
+auto dotenv::shared_env::size() const -> size_t {
+    if (!segment_) {
+        return 0;
+    }
+    return segment_->read([](const detail::image::layout *layout) -> size_t {
+        return (layout != nullptr) ? layout->entry_count : 0;
+    });
+}
+
+auto dotenv::shared_env::version() const noexcept -> std::uint64_t {
+    if (!segment_) {
+        return 0;
+    }
+    return shared_word(segment_->header().sequence)
+               .load(std::memory_order_acquire) /
+           2;
+}
+
+#else // _WIN32
+
+// shm_open/flock não existem no Windows
+auto dotenv::publish_shared(std::string_view /*name*/, size_t /*capacity*/,
+                            unsigned int /*mode*/) noexcept -> dotenv_error {
+    return dotenv_error::invalid_argument;
+}
+
+auto dotenv::unlink_shared(std::string_view /*name*/) noexcept
+    -> dotenv_error {
+    return dotenv_error::invalid_argument;
+}
+
+auto dotenv::attach_shared(std::string_view /*name*/) noexcept
+    -> std::pair<dotenv_error, shared_env> {
+    return {dotenv_error::invalid_argument, {}};
+}
+
+struct dotenv::shared_env::segment {};
+
+auto dotenv::shared_env::find(std::string_view /*key*/) const
+    -> std::optional<std::string> {
+    return std::nullopt;
+}
+
+auto dotenv::shared_env::get(std::string_view /*key*/,
+                             std::string_view default_value) const
+    -> std::string {
+    return std::string(default_value);
+}
+
+auto dotenv::shared_env::contains(std::string_view /*key*/) const -> bool {
+    return false;
+}
+
+auto dotenv::shared_env::size() const -> size_t { return 0; }
+
+auto dotenv::shared_env::version() const noexcept -> std::uint64_t {
+    return 0;
+}
+
+#endif
@@ -3,7 +3,8 @@
 
 #ifdef DOTENV_SIMD_ENABLED
 
-#include "dotenv_mmap.hpp" // Memory-mapping support
+#include "dotenv_mmap.hpp"   // Memory-mapping support
+#include "dotenv_parser.hpp" // Parser shared with the traditional backend
 #include <array>
 #include <cpuid.h>
 #include <cstring>
@@ -55,6 +56,25 @@ auto count_lines_avx2(std::string_view content,
     return line_count;
 }
 
+auto find_newline_avx2(std::string_view content, size_t from) noexcept
+    -> size_t {
+    const auto line_feed = _mm256_set1_epi8('\n');
+    size_t pos = from;
+
+    for (; pos + AVX2_VECTOR_SIZE <= content.size(); pos += AVX2_VECTOR_SIZE) {
+        const auto mem = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(content.data() + pos));
+        const auto mask = static_cast<unsigned int>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(mem, line_feed)));
+        if (mask != 0) {
+            return pos + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+
+    // Tail shorter than one vector
+    return content.find('\n', pos);
+}
+
 // Simplified return type for C++20 compatibility
 auto load_simd_mmap(const std::string &filename)
     -> std::optional<std::unordered_map<std::string, std::string>> {
@@ -72,51 +92,16 @@ auto load_simd_mmap(const std::string &filename)
                                       std::string>{}; // Empty file is valid
         }
 
-        // Use SIMD-optimized callback-based parsing with zero-copy string_view
+        // Same state machine as the traditional backend; AVX2 only finds
+        // line ends. Last definition of a key wins.
         std::unordered_map<std::string, std::string> env_vars;
-
-        // Process lines with callback for memory efficiency
-        std::function<void(size_t, std::string_view)> parse_callback =
-            [&env_vars](size_t /* line_idx */, std::string_view line) {
-                // Skip empty lines and comments
-                if (line.empty() || line[0] == '#') {
-                    return;
-                }
-
-                // Find the '=' separator
-                const auto eq_pos = line.find('=');
-                if (eq_pos == std::string_view::npos) {
-                    return; // Skip malformed lines
-                }
-
-                auto key = line.substr(0, eq_pos);
-                auto value = line.substr(eq_pos + 1);
-
-                // Trim whitespace efficiently
-                while (!key.empty() &&
-                       (key.back() == ' ' || key.back() == '\t')) {
-                    key.remove_suffix(1);
-                }
-                while (!key.empty() &&
-                       (key.front() == ' ' || key.front() == '\t')) {
-                    key.remove_prefix(1);
-                }
-
-                // Remove quotes from value if present
-                if (value.size() >= 2 &&
-                    ((value.front() == '"' && value.back() == '"') ||
-                     (value.front() == '\'' && value.back() == '\''))) {
-                    value.remove_prefix(1);
-                    value.remove_suffix(1);
-                }
-
-                if (!key.empty()) {
-                    env_vars.emplace(std::string(key), std::string(value));
-                }
-            };
-
-        [[maybe_unused]] auto line_count =
-            process_lines_avx2(file_view, '\n', parse_callback);
+        dotenv::detail::parse_content(
+            file_view,
+            [&env_vars](dotenv::detail::parsed_entry &&entry) {
+                env_vars.insert_or_assign(std::string(entry.key),
+                                          std::move(entry.value));
+            },
+            find_newline_avx2);
 
         return env_vars;
 
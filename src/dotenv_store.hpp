@@ -0,0 +1,655 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#ifdef DOTENV_STORE_SHARED_MUTEX
+#include <shared_mutex>
+#endif
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "dotenv_types.h"
+
+// Store interno compartilhado entre as unidades de tradução da biblioteca.
+// Não é instalado: a API pública é dotenv.hpp / dotenv.h.
+namespace dotenv {
+struct change_set;
+} // namespace dotenv
+
+namespace dotenv::detail {
+
+struct parse_stats; // dotenv_parser.hpp
+class budget_meter; // dotenv_budget.hpp
+
+// Estrutura para armazenar valor e flag de gerenciamento
+struct ValueStruct {
+    std::string data;
+    bool managedKey{};
+    // data é um template expandido no primeiro acesso (interpolation::lazy)
+    bool deferred{};
+    // Origem da definição: 1 + índice na tabela de arquivos (0 se não veio
+    // de um arquivo, como em set()), linha a partir de 1 e offset em bytes
+    // do início dessa linha
+    std::uint32_t source{};
+    std::uint32_t line{};
+    std::uint32_t offset{};
+
+    ValueStruct() = default;
+    ValueStruct(std::string value, bool managed, bool is_deferred = false)
+        : data(std::move(value)), managedKey(managed), deferred(is_deferred) {}
+};
+
+// Hash transparente: permite buscar por string_view sem alocar std::string
+struct string_hash {
+    using is_transparent = void;
+
+    auto operator()(std::string_view str) const noexcept -> size_t {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+
+using env_map =
+    std::unordered_map<std::string, ValueStruct, string_hash, std::equal_to<>>;
+using key_set = std::unordered_set<std::string, string_hash, std::equal_to<>>;
+// Valores adiados já expandidos, por chave
+using expansion_memo =
+    std::unordered_map<std::string, std::string, string_hash, std::equal_to<>>;
+
+// Número de shards do store; potência de dois para seleção por máscara
+inline constexpr size_t store_shard_count = 16;
+static_assert(std::has_single_bit(store_shard_count),
+              "store_shard_count must be a power of two");
+static_assert(store_shard_count <= 32, "batch tracks shards in 32 bits");
+
+// Seleciona o shard pelos bits altos do hash (hash de Fibonacci), que não se
+// correlacionam com o bucket usado dentro do unordered_map do shard
+inline auto shard_index(std::string_view key) noexcept -> size_t {
+    constexpr std::uint64_t golden_ratio = 0x9E3779B97F4A7C15ULL;
+    constexpr auto shard_bits =
+        static_cast<unsigned>(std::countr_zero(store_shard_count));
+    const auto mixed =
+        static_cast<std::uint64_t>(string_hash{}(key)) * golden_ratio;
+    return static_cast<size_t>(mixed >> (64U - shard_bits));
+}
+
+// Tabela de um shard. Imutável enquanto estiver referenciada por um snapshot:
+// escritores fazem copy-on-write quando a tabela está fixada.
+// enable_shared_from_this deixa leitores sem lock (env_store::pin_shard)
+// tomarem posse da tabela a partir do ponteiro publicado.
+struct shard_table : std::enable_shared_from_this<shard_table> {
+    env_map entries;
+    // Snapshots que referenciam esta tabela. Incrementado sob o lock do shard
+    // (pin) ou sem lock (pin_shard) e decrementado (release) quando o
+    // snapshot é destruído.
+    mutable std::atomic<std::uint32_t> pins{0};
+
+    shard_table() = default;
+    shard_table(const shard_table &other)
+        : std::enable_shared_from_this<shard_table>(), entries(other.entries) {}
+    auto operator=(const shard_table &) -> shard_table & = delete;
+
+    using sorted_index = std::vector<const env_map::value_type *>;
+
+    // Entradas ordenadas por chave, montadas na primeira busca por prefixo.
+    // Só chamar com a tabela fixada; env_store::writable() descarta o índice
+    // antes de modificar a tabela no lugar.
+    [[nodiscard]] auto sorted() const -> const sorted_index & {
+        std::lock_guard lock(index_mutex);
+        if (!index) {
+            auto built = std::make_unique<sorted_index>();
+            built->reserve(entries.size());
+            for (const auto &entry : entries) {
+                built->push_back(&entry);
+            }
+            std::sort(built->begin(), built->end(),
+                      [](const auto *lhs, const auto *rhs) {
+                          return lhs->first < rhs->first;
+                      });
+            index = std::move(built);
+        }
+        return *index;
+    }
+
+    mutable std::mutex index_mutex;
+    mutable std::unique_ptr<const sorted_index> index;
+};
+
+// Estado fixado de todos os shards (conteúdo de um dotenv::snapshot)
+struct env_table {
+    std::array<std::shared_ptr<const shard_table>, store_shard_count> shards;
+    // Geração de cada shard quando a sua tabela foi fixada
+    std::array<std::uint64_t, store_shard_count> generations{};
+
+    env_table() = default;
+    env_table(const env_table &) = delete;
+    auto operator=(const env_table &) -> env_table & = delete;
+
+    ~env_table() { release(); }
+
+    // Solta as tabelas fixadas; o env_table pode ser fixado de novo
+    void release() noexcept {
+        for (auto &shard : shards) {
+            if (shard) {
+                // Publica as leituras do snapshot antes de liberar a tabela
+                shard->pins.fetch_sub(1, std::memory_order_release);
+                shard.reset();
+            }
+        }
+        std::lock_guard lock(expanded_mutex);
+        expanded.clear();
+    }
+
+    [[nodiscard]] auto find(std::string_view key) const noexcept
+        -> const ValueStruct * {
+        const auto &entries = shards[shard_index(key)]->entries;
+        auto it = entries.find(key);
+        return (it != entries.end()) ? &it->second : nullptr;
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_t {
+        size_t total = 0;
+        for (const auto &shard : shards) {
+            total += shard->entries.size();
+        }
+        return total;
+    }
+
+    // fn(key, value) para cada entrada; as tabelas fixadas não mudam, então
+    // não há lock a segurar
+    template <class Fn>
+    void for_each(Fn &&fn) const {
+        for (const auto &shard : shards) {
+            for (const auto &[key, value] : shard->entries) {
+                fn(key, value);
+            }
+        }
+    }
+
+    // Como for_each, mas fn retorna false para interromper; retorna o número
+    // de entradas visitadas antes da interrupção
+    template <class Fn>
+    auto for_each_until(Fn &&fn) const -> size_t {
+        size_t visited = 0;
+        for (const auto &shard : shards) {
+            for (const auto &[key, value] : shard->entries) {
+                if (!fn(key, value)) {
+                    return visited;
+                }
+                ++visited;
+            }
+        }
+        return visited;
+    }
+
+    // fn(key, value) para as entradas cuja chave começa com `prefix`, em
+    // ordem de chave dentro de cada shard (busca binária no índice ordenado)
+    template <class Fn>
+    void for_each_with_prefix(std::string_view prefix, Fn &&fn) const {
+        for (const auto &shard : shards) {
+            const auto &index = shard->sorted();
+            auto it = std::lower_bound(
+                index.begin(), index.end(), prefix,
+                [](const auto *entry, std::string_view bound) {
+                    return std::string_view(entry->first) < bound;
+                });
+            for (; it != index.end() && (*it)->first.starts_with(prefix);
+                 ++it) {
+                fn((*it)->first, (*it)->second);
+            }
+        }
+    }
+
+    // Expansões dos valores adiados deste estado, feitas sob demanda
+    mutable std::mutex expanded_mutex;
+    mutable expansion_memo expanded;
+    // false se as expansões não consultam o ambiente do processo
+    bool process_env{true};
+};
+
+/**
+ * @brief Store particionado em shards, cada um com seu próprio lock
+ *
+ * Operações por chave travam apenas o shard da chave. Operações que precisam
+ * de consistência global (snapshot, enumeração, salvamento, limpeza) travam
+ * todos os shards em ordem crescente de índice, o que evita deadlocks.
+ *
+ * Com DOTENV_STORE_SHARED_MUTEX os shards usam std::shared_mutex: leituras
+ * (get, value, contains, enumeração, snapshot) rodam em paralelo e só as
+ * escritas são exclusivas.
+ */
+class env_store {
+  public:
+#ifdef DOTENV_STORE_SHARED_MUTEX
+    using mutex_type = std::shared_mutex;
+    using read_lock = std::shared_lock<mutex_type>;
+#else
+    using mutex_type = std::mutex;
+    using read_lock = std::unique_lock<mutex_type>;
+#endif
+    using write_lock = std::unique_lock<mutex_type>;
+
+    env_store() {
+        for (auto &shard : shards_) {
+            shard.table = std::make_shared<shard_table>();
+            shard.published.store(shard.table.get(), std::memory_order_release);
+        }
+    }
+
+    env_store(const env_store &) = delete;
+    auto operator=(const env_store &) -> env_store & = delete;
+
+    // fn(const ValueStruct *) sob o lock do shard (nullptr se ausente)
+    template <class Fn>
+    auto read(std::string_view key, Fn &&fn) const {
+        const auto &shard = shards_[shard_index(key)];
+        read_lock lock(shard.mutex);
+        auto it = shard.table->entries.find(key);
+        return std::forward<Fn>(fn)(
+            (it != shard.table->entries.end()) ? &it->second : nullptr);
+    }
+
+    // fn(env_map &) sob o lock do shard, com a tabela pronta para escrita
+    template <class Fn>
+    auto write(std::string_view key, Fn &&fn) {
+        auto &shard = shards_[shard_index(key)];
+        write_lock lock(shard.mutex);
+        write_section section(shard);
+        return std::forward<Fn>(fn)(writable(shard));
+    }
+
+    // Lote de escritas feito com todos os shards travados: leitores e
+    // snapshots veem o estado anterior ou o lote inteiro, nunca metade dele
+    class batch {
+      public:
+        [[nodiscard]] auto find(std::string_view key) const noexcept
+            -> const ValueStruct * {
+            const auto &shard = store_.shards_[shard_index(key)];
+            const auto &entries = shard.table->entries;
+            auto it = entries.find(key);
+            return (it != entries.end()) ? &it->second : nullptr;
+        }
+
+        // fn(key, value) para cada entrada no início do lote
+        template <class Fn> void for_each(Fn &&fn) const {
+            for (const auto &shard : store_.shards_) {
+                for (const auto &[key, value] : shard.table->entries) {
+                    fn(key, value);
+                }
+            }
+        }
+
+        // Tabela do shard da chave, clonada no máximo uma vez por lote. A
+        // geração do shard fica ímpar até o fim do lote.
+        auto entries_for(std::string_view key) -> env_map & {
+            const auto index = shard_index(key);
+            auto &shard = store_.shards_[index];
+            if ((touched_ & (1U << index)) != 0) {
+                return shard.table->entries;
+            }
+            touched_ |= (1U << index);
+            shard.generation.fetch_add(1, std::memory_order_seq_cst);
+            return store_.writable(shard);
+        }
+
+        batch(const batch &) = delete;
+        auto operator=(const batch &) -> batch & = delete;
+
+        ~batch() {
+            for (size_t i = 0; i < store_shard_count; ++i) {
+                if ((touched_ & (1U << i)) != 0) {
+                    store_.shards_[i].generation.fetch_add(
+                        1, std::memory_order_release);
+                }
+            }
+        }
+
+      private:
+        friend class env_store;
+        explicit batch(env_store &store) noexcept : store_(store) {}
+
+        env_store &store_;
+        std::uint32_t touched_{0};
+    };
+
+    // fn(batch &) com todos os shards travados para escrita
+    template <class Fn>
+    auto write_batch(Fn &&fn) {
+        all_shards_lock<shared_access::no> lock(*this);
+        batch pending(*this);
+        return std::forward<Fn>(fn)(pending);
+    }
+
+    // Remove a chave; não clona a tabela se não houver nada a remover
+    auto erase(std::string_view key) -> bool {
+        auto &shard = shards_[shard_index(key)];
+        write_lock lock(shard.mutex);
+        if (!shard.table->entries.contains(key)) {
+            return false;
+        }
+        write_section section(shard);
+        auto &entries = writable(shard);
+        entries.erase(entries.find(key));
+        return true;
+    }
+
+    // fn(key, value) para cada entrada, com todos os shards travados
+    template <class Fn>
+    void for_each(Fn &&fn) const {
+        all_shards_lock<shared_access::yes> lock(*this);
+        for (const auto &shard : shards_) {
+            for (const auto &[key, value] : shard.table->entries) {
+                fn(key, value);
+            }
+        }
+    }
+
+    // Como for_each, mas fn retorna false para interromper; retorna o número
+    // de entradas visitadas antes da interrupção
+    template <class Fn>
+    auto for_each_until(Fn &&fn) const -> size_t {
+        all_shards_lock<shared_access::yes> lock(*this);
+        size_t visited = 0;
+        for (const auto &shard : shards_) {
+            for (const auto &[key, value] : shard.table->entries) {
+                if (!fn(key, value)) {
+                    return visited;
+                }
+                ++visited;
+            }
+        }
+        return visited;
+    }
+
+    // Esvazia o store; on_entry(key, value) é chamado antes da remoção.
+    // Snapshots continuam com as tabelas anteriores.
+    template <class Fn>
+    void clear(Fn &&on_entry) {
+        all_shards_lock<shared_access::no> lock(*this);
+        for (auto &shard : shards_) {
+            for (const auto &[key, value] : shard.table->entries) {
+                on_entry(key, value);
+            }
+            // Troca de tabela sem escrita no lugar: a geração segue par
+            replace_table(shard, std::make_shared<shard_table>());
+            shard.generation.fetch_add(2, std::memory_order_release);
+        }
+    }
+
+    // Fixa o estado atual de todos os shards; retorna a geração observada
+    [[nodiscard]] auto pin() const
+        -> std::pair<std::shared_ptr<env_table>, std::uint64_t> {
+        auto pinned = std::make_shared<env_table>();
+        all_shards_lock<shared_access::yes> lock(*this);
+        std::uint64_t generation = 0;
+        for (size_t i = 0; i < store_shard_count; ++i) {
+            shards_[i].table->pins.fetch_add(1, std::memory_order_relaxed);
+            pinned->shards[i] = shards_[i].table;
+            pinned->generations[i] =
+                shards_[i].generation.load(std::memory_order_relaxed);
+            generation += pinned->generations[i];
+        }
+        return {std::move(pinned), generation / 2};
+    }
+
+    // Fixa só a tabela do shard `index` em `table`, sem o lock do shard.
+    // Usado por leituras otimistas, que conferem com validate() no final; um
+    // env_table parcial só serve para find() das chaves dos shards fixados.
+    // Espera (yield) enquanto um escritor modifica a tabela no lugar.
+    void pin_shard(env_table &table, size_t index) const {
+        const auto &shard = shards_[index];
+        while (!try_pin_shard(table, index, shard)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // true se nenhum shard fixado em `table` mudou desde a fixação
+    [[nodiscard]] auto validate(const env_table &table) const noexcept
+        -> bool {
+        for (size_t i = 0; i < store_shard_count; ++i) {
+            if (table.shards[i] &&
+                shards_[i].generation.load(std::memory_order_acquire) !=
+                    table.generations[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Metade da soma das gerações dos shards (cada escrita soma 2 à geração
+    // do seu shard). Sem locks a soma não é atômica entre shards, mas nunca
+    // diminui e muda a cada escrita.
+    [[nodiscard]] auto generation() const noexcept -> std::uint64_t {
+        std::uint64_t generation = 0;
+        for (const auto &shard : shards_) {
+            generation += shard.generation.load(std::memory_order_acquire);
+        }
+        return generation / 2;
+    }
+
+  private:
+    // Alinhado à linha de cache para evitar false sharing entre locks. A
+    // geração fica no próprio shard: escritores em shards diferentes não
+    // disputam um contador comum.
+    struct alignas(64) shard {
+        mutable mutex_type mutex;
+        // Tabela atual, trocada sob o lock exclusivo
+        std::shared_ptr<shard_table> table;
+        // table.get(), para leitores sem lock
+        std::atomic<shard_table *> published{nullptr};
+        // Leitores sem lock entre ler `published` e tomar posse da tabela
+        mutable std::atomic<std::uint32_t> readers{0};
+        // Soma 2 a cada modificação; ímpar enquanto a tabela é modificada no
+        // lugar
+        std::atomic<std::uint64_t> generation{0};
+    };
+
+    // Escrita no lugar em um shard: a geração fica ímpar até o fim
+    class write_section {
+      public:
+        explicit write_section(shard &target) noexcept : target_(target) {
+            // seq_cst: ordenado antes da leitura de pins em writable()
+            target_.generation.fetch_add(1, std::memory_order_seq_cst);
+        }
+        ~write_section() {
+            target_.generation.fetch_add(1, std::memory_order_release);
+        }
+
+        write_section(const write_section &) = delete;
+        auto operator=(const write_section &) -> write_section & = delete;
+
+      private:
+        shard &target_;
+    };
+
+    enum class shared_access { no, yes };
+
+    // Trava todos os shards em ordem crescente e libera em ordem reversa.
+    // shared_access::yes usa lock compartilhado quando disponível.
+    template <shared_access Access>
+    class all_shards_lock {
+      public:
+        explicit all_shards_lock(const env_store &store) : store_(store) {
+            for (const auto &shard : store_.shards_) {
+                lock_one(shard.mutex);
+            }
+        }
+
+        ~all_shards_lock() {
+            for (auto it = store_.shards_.rbegin(); it != store_.shards_.rend();
+                 ++it) {
+                unlock_one(it->mutex);
+            }
+        }
+
+        all_shards_lock(const all_shards_lock &) = delete;
+        auto operator=(const all_shards_lock &) -> all_shards_lock & = delete;
+
+      private:
+        static void lock_one(mutex_type &mutex) {
+#ifdef DOTENV_STORE_SHARED_MUTEX
+            if constexpr (Access == shared_access::yes) {
+                mutex.lock_shared();
+                return;
+            }
+#endif
+            mutex.lock();
+        }
+
+        static void unlock_one(mutex_type &mutex) {
+#ifdef DOTENV_STORE_SHARED_MUTEX
+            if constexpr (Access == shared_access::yes) {
+                mutex.unlock_shared();
+                return;
+            }
+#endif
+            mutex.unlock();
+        }
+
+        const env_store &store_;
+    };
+
+    // Requer o lock exclusivo do shard e a geração já ímpar. Se algum
+    // snapshot ainda aponta para a tabela, ela é clonada antes de ser
+    // modificada; o acquire sincroniza com o release do último snapshot
+    // liberado antes de reutilizá-la.
+    //
+    // Um leitor sem lock incrementa pins e depois lê a geração; aqui a
+    // geração foi incrementada antes de ler pins (ambos seq_cst). Ou este
+    // escritor vê o pin e clona, ou o leitor vê a geração ímpar e desiste.
+    auto writable(shard &target) -> env_map & {
+        if (target.table->pins.load(std::memory_order_seq_cst) != 0) {
+            replace_table(target,
+                          std::make_shared<shard_table>(*target.table));
+        } else {
+            target.table->index.reset();
+        }
+        return target.table->entries;
+    }
+
+    // Requer o lock exclusivo do shard. A tabela anterior só é solta depois
+    // que nenhum leitor sem lock pode estar tomando posse dela.
+    static void replace_table(shard &target,
+                              std::shared_ptr<shard_table> next) {
+        auto previous = std::exchange(target.table, std::move(next));
+        target.published.store(target.table.get(), std::memory_order_seq_cst);
+        while (target.readers.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Um passo de pin_shard; false se um escritor está no meio de uma escrita
+    // no lugar ou trocou a tabela, e o leitor deve tentar de novo
+    static auto try_pin_shard(env_table &table, size_t index,
+                              const shard &source) -> bool {
+        source.readers.fetch_add(1, std::memory_order_seq_cst);
+        auto *current = source.published.load(std::memory_order_seq_cst);
+        std::shared_ptr<const shard_table> owned = current->shared_from_this();
+        source.readers.fetch_sub(1, std::memory_order_release);
+
+        owned->pins.fetch_add(1, std::memory_order_seq_cst);
+        const auto generation =
+            source.generation.load(std::memory_order_seq_cst);
+        if ((generation & 1U) != 0 ||
+            source.published.load(std::memory_order_seq_cst) != current) {
+            owned->pins.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+        table.shards[index] = std::move(owned);
+        table.generations[index] = generation;
+        return true;
+    }
+
+    std::array<shard, store_shard_count> shards_;
+};
+
+// Estado de um dotenv::environment (definido em dotenv.cpp)
+struct environment_state;
+
+// Store global usado pelas funções livres
+[[nodiscard]] auto global_store() noexcept -> env_store &;
+
+// Valor de uma entrada de um estado fixado; valores adiados são expandidos
+// contra o próprio estado e guardados nele, então a referência vale enquanto
+// a tabela estiver fixada
+auto pinned_value(const env_table &table, std::string_view key,
+                  const ValueStruct &value) -> const std::string &;
+
+// Interpreta o conteúdo de um arquivo .env em um mapa privado, sem tocar no
+// store (a última definição de uma chave vence). Chaves com valor entre aspas
+// simples vão para `literal_keys`, se fornecido. Retorna o número de
+// definições válidas.
+// `source` (de register_source) é gravado na origem de cada entrada,
+// `stats`, se fornecido, recebe os contadores do parser. De `options` valem
+// só options.limits (exceto max_file_size, verificado por quem mapeia) e
+// options.on_diagnostic, que recebe o caminho de `source`, e options.strict;
+// o orçamento vem de `meter`, compartilhado entre arquivos de uma carga.
+auto parse_entries(std::string_view content, env_map &entries,
+                   key_set *literal_keys = nullptr, std::uint32_t source = 0,
+                   parse_stats *stats = nullptr,
+                   const load_options &options = {},
+                   budget_meter *meter = nullptr) -> int;
+
+// Lançada por parse_entries com options.strict quando alguma linha foi
+// ignorada ou alterada; a carga falha com invalid_format, sem commit
+struct strict_violation : std::runtime_error {
+    strict_violation() : std::runtime_error("dotenv: invalid line") {}
+};
+
+// parse_entries seguido dos pós-processamentos pedidos em `options`
+// (interpolação), com os limites, diagnósticos e orçamento de `options`.
+// Retorna o número de definições válidas; budget_exceeded se o orçamento
+// se esgotar, com `entries` incompleto.
+auto parse_source(std::string_view content, const load_options &options,
+                  env_map &entries, std::uint32_t source = 0,
+                  parse_stats *stats = nullptr) -> int;
+
+// Identificador compacto de um arquivo de origem, estável durante o
+// processo; o mesmo caminho recebe sempre o mesmo id (a partir de 1)
+auto register_source(std::string_view path) -> std::uint32_t;
+
+// Caminho registrado para `source`; vazio para 0 ou id desconhecido
+auto source_path(std::uint32_t source) -> std::string;
+
+// Posição de uma definição analisada, limitada a 32 bits
+inline void set_location(ValueStruct &value, std::uint32_t source,
+                         size_t line, size_t offset) noexcept {
+    constexpr size_t limit = UINT32_MAX;
+    value.source = source;
+    value.line = static_cast<std::uint32_t>(std::min(line, limit));
+    value.offset = static_cast<std::uint32_t>(std::min(offset, limit));
+}
+
+// Grava `entries` no store de `env` em um único lote, conforme a política de
+// sobrescrita (os valores são movidos), e aplica só essas chaves ao ambiente
+// do processo se pedido
+void commit_loaded(environment_state &env, env_map &entries,
+                   const load_options &options);
+
+// Substitui atomicamente, em um único lote, as entradas vindas de uma fonte.
+// O que a fonte gravou fica num registro por `path` do ambiente padrão,
+// compartilhado por reload() e watch(), completado a cada chamada com as
+// entradas do store cuja origem é `path` (gravadas por load(), camadas
+// etc.): chaves que sumiram de `next` são removidas e as demais gravadas
+// conforme a política, mas uma chave da fonte só é removida ou substituída
+// se o store ainda tem o valor que ela gravou.
+// Aplica ao ambiente do processo se pedido. Não notifica os observadores.
+auto commit_source(std::string_view path, const env_map &next, bool replace,
+                   bool apply_system_env) -> change_set;
+
+// Entrega as mudanças aos observadores de subscribe(); chamar sem locks
+void publish_changes(const change_set &changes) noexcept;
+
+} // namespace dotenv::detail
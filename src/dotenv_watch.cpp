@@ -0,0 +1,326 @@
+#include "dotenv.hpp"
+#include "dotenv_budget.hpp"
+#include "dotenv_mmap.hpp"
+#include "dotenv_store.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using dotenv::detail::env_map;
+
+#ifdef __linux__
+
+namespace {
+
+// Eventos do diretório que podem alterar o arquivo observado: escrita no
+// lugar, criação e rename-replace (o arquivo novo chega via IN_MOVED_TO)
+// Com eventos chegando sem parar (diretório movimentado, symlink), a recarga
+// acontece no máximo este múltiplo do debounce após o primeiro evento
+constexpr int max_latency_factor = 10;
+
+constexpr std::uint32_t watched_events = IN_CLOSE_WRITE | IN_MODIFY |
+                                         IN_CREATE | IN_MOVED_TO |
+                                         IN_MOVED_FROM | IN_DELETE;
+
+[[noreturn]] void throw_errno(const char *what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Descritor de arquivo com fechamento automático
+class unique_fd {
+  public:
+    explicit unique_fd(int fd) noexcept : fd_(fd) {}
+    ~unique_fd() noexcept {
+        if (fd_ != -1) {
+            ::close(fd_);
+        }
+    }
+
+    unique_fd(const unique_fd &) = delete;
+    auto operator=(const unique_fd &) -> unique_fd & = delete;
+
+    [[nodiscard]] auto get() const noexcept -> int { return fd_; }
+
+  private:
+    int fd_;
+};
+
+} // namespace
+
+struct dotenv::watch_handle::watcher {
+    watcher(std::string_view file_path, const load_options &options,
+            watch_callback on_change, std::chrono::milliseconds quiet_period)
+        : path(file_path), source(dotenv::detail::register_source(file_path)),
+          replace(options.overwrite_policy == overwrite::replace),
+          apply_system_env(options.apply_to_process == process_env_apply::yes),
+          expansion(options.expansion), on_diagnostic(options.on_diagnostic),
+          limits(options.limits), budget(options.budget),
+          strict(options.strict),
+          callback(std::move(on_change)),
+          debounce(quiet_period),
+          inotify_fd(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)),
+          stop_fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        if (inotify_fd.get() == -1 || stop_fd.get() == -1) {
+            throw_errno("dotenv::watch: cannot create inotify instance");
+        }
+
+        const auto parent = path.has_parent_path()
+                                ? path.parent_path()
+                                : std::filesystem::path(".");
+        if (::inotify_add_watch(inotify_fd.get(), parent.c_str(),
+                                watched_events) == -1) {
+            throw_errno("dotenv::watch: cannot watch directory");
+        }
+
+        // Symlink (ex.: ConfigMap do Kubernetes): a troca acontece em outra
+        // entrada do diretório, então qualquer evento dispara a recarga
+        std::error_code error_code;
+        follow_any_event = std::filesystem::is_symlink(path, error_code);
+        file_name = path.filename().string();
+
+        reload();
+        worker = std::thread([this]() { run(); });
+    }
+
+    watcher(const watcher &) = delete;
+    auto operator=(const watcher &) -> watcher & = delete;
+
+    ~watcher() { stop(); }
+
+    void stop() noexcept {
+        if (!worker.joinable()) {
+            return;
+        }
+        const std::uint64_t signal = 1;
+        [[maybe_unused]] auto written =
+            ::write(stop_fd.get(), &signal, sizeof(signal));
+        worker.join();
+    }
+
+    // Reparse fora do caminho de leitura e troca atômica no store. Arquivo
+    // ausente, ilegível, acima do orçamento ou, com strict, com linhas
+    // inválidas mantém o estado atual.
+    auto reload() -> change_set {
+        mapped_file file;
+        try {
+            if (!file.map(path.string()) ||
+                file.view().size() > limits.max_file_size) {
+                return {};
+            }
+        } catch (const std::exception &) {
+            return {};
+        }
+
+        env_map next;
+        try {
+            dotenv::detail::parse_source(file.view(),
+                                         {.expansion = expansion,
+                                          .on_diagnostic = on_diagnostic,
+                                          .limits = limits,
+                                          .budget = budget,
+                                          .strict = strict},
+                                         next, source);
+        } catch (const dotenv::detail::budget_exceeded &) {
+            return {};
+        } catch (const dotenv::detail::strict_violation &) {
+            return {};
+        }
+        file.close();
+
+        return dotenv::detail::commit_source(path.string(), next, replace,
+                                             apply_system_env);
+    }
+
+    // Consome os eventos pendentes; true se algum afeta o arquivo observado
+    auto drain_events() -> bool {
+        alignas(inotify_event) char buffer[4096];
+        bool relevant = false;
+
+        for (;;) {
+            const auto length =
+                ::read(inotify_fd.get(), buffer, sizeof(buffer));
+            if (length <= 0) {
+                return relevant;
+            }
+
+            for (ssize_t offset = 0; offset < length;) {
+                const auto *event =
+                    reinterpret_cast<const inotify_event *>(buffer + offset);
+                if ((event->mask & IN_IGNORED) != 0) {
+                    directory_gone = true;
+                } else if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                    // Eventos perdidos podem incluir uma troca do arquivo
+                    relevant = true;
+                } else if (follow_any_event ||
+                           (event->len > 0 && file_name == event->name)) {
+                    relevant = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event) +
+                                               event->len);
+            }
+        }
+    }
+
+    // Debounce: a recarga só acontece após `debounce` sem novos eventos, ou
+    // quando o primeiro evento pendente passa da latência máxima
+    void run() {
+        using clock = std::chrono::steady_clock;
+        std::array<pollfd, 2> fds{{{inotify_fd.get(), POLLIN, 0},
+                                   {stop_fd.get(), POLLIN, 0}}};
+        bool pending = false;
+        clock::time_point deadline{};
+
+        while (!directory_gone) {
+            int timeout = -1;
+            if (pending) {
+                const auto remaining =
+                    std::chrono::ceil<std::chrono::milliseconds>(
+                        deadline - clock::now());
+                timeout = static_cast<int>(std::max<std::int64_t>(
+                    std::min(remaining, debounce).count(), 0));
+            }
+            const int ready = ::poll(fds.data(), fds.size(), timeout);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+
+            if ((fds[1].revents & POLLIN) != 0) {
+                break;
+            }
+
+            if (ready == 0) {
+                pending = false;
+                notify(reload_noexcept());
+                continue;
+            }
+
+            if ((fds[0].revents & POLLIN) != 0 && drain_events() &&
+                !pending) {
+                pending = true;
+                deadline = clock::now() + debounce * max_latency_factor;
+            }
+            if (pending && clock::now() >= deadline) {
+                pending = false;
+                notify(reload_noexcept());
+            }
+        }
+        running.store(false, std::memory_order_release);
+    }
+
+    auto reload_noexcept() noexcept -> change_set {
+        try {
+            return reload();
+        } catch (const std::exception &) {
+            return {};
+        }
+    }
+
+    // Callback do watch com todas as chaves, depois os observadores
+    void notify(const change_set &changes) noexcept {
+        if (changes.empty()) {
+            return;
+        }
+        if (callback) {
+            try {
+                std::vector<std::string> keys;
+                keys.reserve(changes.added.size() + changes.removed.size() +
+                             changes.changed.size());
+                for (const auto *part :
+                     {&changes.added, &changes.removed, &changes.changed}) {
+                    keys.insert(keys.end(), part->begin(), part->end());
+                }
+                std::sort(keys.begin(), keys.end());
+                callback(keys);
+            } catch (...) {
+                // Exceções do callback não podem derrubar a thread do watcher
+            }
+        }
+        dotenv::detail::publish_changes(changes);
+    }
+
+    std::filesystem::path path;
+    std::uint32_t source;
+    std::string file_name;
+    bool replace;
+    bool apply_system_env;
+    interpolation expansion;
+    diagnostic_sink on_diagnostic;
+    parse_limits limits;
+    load_budget budget;
+    bool strict;
+    bool follow_any_event{false};
+    bool directory_gone{false};
+    watch_callback callback;
+    std::chrono::milliseconds debounce;
+    unique_fd inotify_fd;
+    unique_fd stop_fd;
+    std::atomic<bool> running{true};
+    std::thread worker;
+};
+
+#else
+
+struct dotenv::watch_handle::watcher {
+    std::atomic<bool> running{false};
+    void stop() noexcept {}
+};
+
+#endif
+
+dotenv::watch_handle::watch_handle() noexcept = default;
+
+dotenv::watch_handle::watch_handle(std::unique_ptr<watcher> impl) noexcept
+    : impl_(std::move(impl)) {}
+
+dotenv::watch_handle::~watch_handle() = default;
+
+dotenv::watch_handle::watch_handle(watch_handle &&other) noexcept = default;
+
+auto dotenv::watch_handle::operator=(watch_handle &&other) noexcept
+    -> watch_handle & = default;
+
+void dotenv::watch_handle::stop() noexcept {
+    if (impl_) {
+        impl_->stop();
+    }
+}
+
+auto dotenv::watch_handle::active() const noexcept -> bool {
+    return impl_ && impl_->running.load(std::memory_order_acquire);
+}
+
+auto dotenv::watch(std::string_view path, const load_options &options,
+                   watch_callback callback, std::chrono::milliseconds debounce)
+    -> watch_handle {
+#ifdef __linux__
+    return watch_handle(std::make_unique<watch_handle::watcher>(
+        path, options, std::move(callback), debounce));
+#else
+    (void)path;
+    (void)options;
+    (void)callback;
+    (void)debounce;
+    throw std::system_error(
+        std::make_error_code(std::errc::function_not_supported),
+        "dotenv::watch requires inotify");
+#endif
+}
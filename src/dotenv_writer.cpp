@@ -0,0 +1,190 @@
+#include "dotenv_writer.hpp"
+#include <atomic>
+#include <cerrno>
+#include <filesystem>
+#include <string>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr auto is_blank(char chr) noexcept -> bool {
+    return chr == ' ' || chr == '\t';
+}
+
+// O parser devolveria o valor sem aspas exatamente como está
+auto plain_safe(std::string_view value) noexcept -> bool {
+    if (value.empty()) {
+        return true;
+    }
+    return !is_blank(value.front()) && !is_blank(value.back()) &&
+           value.front() != '"' && value.front() != '\'' &&
+           value.find_first_of("\n\r#$") == std::string_view::npos;
+}
+
+void append_double_quoted(std::string &out, std::string_view value) {
+    out += '"';
+    for (const char chr : value) {
+        switch (chr) {
+        case '\\':
+            out += "\\\\";
+            break;
+        case '"':
+            out += "\\\"";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        default:
+            out += chr;
+            break;
+        }
+    }
+    out += '"';
+}
+
+// Nome único no mesmo diretório, para que o rename seja atômico
+auto temporary_path(const std::string &path) -> std::string {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    const auto process = 0UL;
+#else
+    const auto process = static_cast<unsigned long>(::getpid());
+#endif
+    return path + ".tmp." + std::to_string(process) + "." +
+           std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+}
+
+// rename() substitui o próprio link: grava no destino final para que um
+// .env que é symlink continue link e o arquivo apontado seja atualizado
+auto resolved_target(const std::string &path) -> std::string {
+    std::error_code error_code;
+    auto resolved = std::filesystem::weakly_canonical(path, error_code);
+    return error_code ? path : resolved.string();
+}
+
+auto last_error() noexcept -> std::error_code {
+    return {errno, std::generic_category()};
+}
+
+} // namespace
+
+void dotenv::detail::append_assignment(std::string &out, std::string_view key,
+                                       std::string_view value) {
+    out += key;
+    out += '=';
+    if (plain_safe(value)) {
+        out += value;
+    } else if (value.find_first_of("'\r") == std::string_view::npos) {
+        out += '\'';
+        out += value;
+        out += '\'';
+    } else {
+        // '$' fica sem escape: "\$" só é reconhecido com interpolação e
+        // voltaria literal com interpolation::none (limite documentado em
+        // save_to_file)
+        append_double_quoted(out, value);
+    }
+    out += '\n';
+}
+
+#ifdef _WIN32
+
+auto dotenv::detail::write_file_atomic(const std::string &target,
+                                       std::string_view data)
+    -> std::error_code {
+    const auto path = resolved_target(target);
+    const auto temporary = temporary_path(path);
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.write(data.data(), static_cast<std::streamsize>(data.size()))
+                 .flush()) {
+            std::error_code ignored;
+            std::filesystem::remove(temporary, ignored);
+            return std::make_error_code(std::errc::io_error);
+        }
+    }
+    std::error_code error_code;
+    std::filesystem::rename(temporary, path, error_code);
+    if (error_code) {
+        std::error_code ignored;
+        std::filesystem::remove(temporary, ignored);
+    }
+    return error_code;
+}
+
+#else
+
+auto dotenv::detail::write_file_atomic(const std::string &target,
+                                       std::string_view data)
+    -> std::error_code {
+    const auto path = resolved_target(target);
+    const auto temporary = temporary_path(path);
+    // 0666 sujeito à umask, como um arquivo criado por std::ofstream
+    const int fd = ::open(temporary.c_str(),
+                          O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (fd == -1) {
+        return last_error();
+    }
+
+    const auto fail = [&](std::error_code error_code) {
+        ::close(fd);
+        ::unlink(temporary.c_str());
+        return error_code;
+    };
+
+    struct stat existing {};
+    if (::stat(path.c_str(), &existing) == 0 &&
+        ::fchmod(fd, existing.st_mode & 07777) != 0) {
+        return fail(last_error());
+    }
+
+    for (size_t written = 0; written < data.size();) {
+        const auto result =
+            ::write(fd, data.data() + written, data.size() - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return fail(last_error());
+        }
+        written += static_cast<size_t>(result);
+    }
+
+    if (::fsync(fd) != 0) {
+        return fail(last_error());
+    }
+    if (::close(fd) != 0) {
+        const auto error_code = last_error();
+        ::unlink(temporary.c_str());
+        return error_code;
+    }
+    if (::rename(temporary.c_str(), path.c_str()) != 0) {
+        const auto error_code = last_error();
+        ::unlink(temporary.c_str());
+        return error_code;
+    }
+
+    // Torna o rename durável; falhar aqui não desfaz a substituição
+    auto directory = std::filesystem::path(path).parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+    const int dir_fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dir_fd != -1) {
+        ::fsync(dir_fd);
+        ::close(dir_fd);
+    }
+    return {};
+}
+
+#endif
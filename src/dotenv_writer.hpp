@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <system_error>
+
+// Escrita de arquivos .env: serialização que o parser lê de volta e
+// substituição atômica do arquivo. Cabeçalho interno, não instalado.
+namespace dotenv::detail {
+
+/**
+ * @brief Acrescenta "KEY=valor\n" a `out`, com aspas quando necessário
+ *
+ * Valores simples ficam sem aspas. Os que o parser alteraria (espaços nas
+ * pontas, aspas iniciais, '#', '$', quebras de linha) usam aspas simples,
+ * que são literais e mantêm '$' fora da interpolação; se o valor tiver
+ * aspas simples ou '\r', usa aspas duplas com \\ \" \n \r escapados.
+ */
+void append_assignment(std::string &out, std::string_view key,
+                       std::string_view value);
+
+/**
+ * @brief Substitui `path` por `data` sem deixar um arquivo parcial
+ *
+ * Grava um temporário no mesmo diretório com uma única chamada de write
+ * (repetida só em escrita parcial), faz fsync, renomeia sobre `path` e
+ * sincroniza o diretório. Um arquivo existente mantém suas permissões. Se
+ * `path` é um symlink, o arquivo apontado é que é substituído e o link fica.
+ *
+ * @return Erro do sistema, ou vazio em caso de sucesso
+ */
+auto write_file_atomic(const std::string &path, std::string_view data)
+    -> std::error_code;
+
+} // namespace dotenv::detail
@@ -1,7 +1,35 @@
 #include "dotenv.hpp"
 #include <iostream>
+#include <string_view>
+
+namespace {
+
+// dotenvexe compile <arquivo.env> <imagem>: gera a imagem lida por
+// dotenv::load_compiled() (etapa de build/deploy)
+auto compile_command(int argc, char **argv) -> int {
+    if (argc != 4) {
+        std::cerr << "usage: " << argv[0] << " compile <input.env> <output>"
+                  << '\n';
+        return 2;
+    }
+
+    auto error = dotenv::compile(argv[2], argv[3],
+                                 {.expansion = dotenv::interpolation::eager});
+    if (error != dotenv::dotenv_error::success) {
+        std::cerr << "Failed to compile " << argv[2] << " (error "
+                  << static_cast<int>(error) << ")" << '\n';
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+    if (argc > 1 && std::string_view(argv[1]) == "compile") {
+        return compile_command(argc, argv);
+    }
 
-auto main() -> int {
     std::cout << "Hello, World!" << '\n';
 
     // Use legacy pair-returning API when structured bindings are desired
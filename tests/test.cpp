@@ -1,8 +1,10 @@
+#include "dotenv.h"
 #include "dotenv.hpp"
 #include <filesystem>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <thread>
+#include <vector>
 #include <unistd.h>
 
 class DotenvTest : public ::testing::Test {
@@ -171,6 +173,87 @@ TEST_F(DotenvTest, ParserRobust) {
     dotenv::unset("QUOTED_EMPTY");
 }
 
+TEST_F(DotenvTest, ParserMultilineCommentsAndExport) {
+    const std::string pem = "-----BEGIN CERTIFICATE-----\n"
+                            "MIIBszCCAVmgAwIBAgIUQ2x\n"
+                            "-----END CERTIFICATE-----";
+    std::ofstream env_file(parser_test_file, std::ios::binary);
+    env_file << "export EXPORTED=exported_value\n";
+    env_file << "INLINE_COMMENT=value # trailing comment\n";
+    env_file << "HASH_IN_VALUE=https://example.com/#anchor\n";
+    env_file << "QUOTED_HASH=\"keep # this\" # but not this\n";
+    env_file << "CERT=\"" << pem << "\"\n";
+    env_file << "SINGLE_MULTI='line one\r\nline two'\n";
+    env_file << "AFTER_MULTI=still_parsed\n";
+    env_file << "UNBALANCED=\"no closing quote\n";
+    env_file << "LAST=last_value\n";
+    env_file.close();
+
+    auto [error, count] = dotenv::load_legacy(
+        parser_test_file.string(),
+        {.apply_to_process = dotenv::process_env_apply::no});
+    EXPECT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(count, 9);
+
+    EXPECT_EQ(dotenv::value("EXPORTED"), "exported_value");
+    EXPECT_EQ(dotenv::value("INLINE_COMMENT"), "value");
+    EXPECT_EQ(dotenv::value("HASH_IN_VALUE"), "https://example.com/#anchor");
+    EXPECT_EQ(dotenv::value("QUOTED_HASH"), "keep # this");
+    EXPECT_EQ(dotenv::value("CERT"), pem);
+    EXPECT_EQ(dotenv::value("SINGLE_MULTI"), "line one\nline two");
+    EXPECT_EQ(dotenv::value("AFTER_MULTI"), "still_parsed");
+    EXPECT_EQ(dotenv::value("UNBALANCED"), "\"no closing quote");
+    EXPECT_EQ(dotenv::value("LAST"), "last_value");
+
+    for (const char *key :
+         {"EXPORTED", "INLINE_COMMENT", "HASH_IN_VALUE", "QUOTED_HASH", "CERT",
+          "SINGLE_MULTI", "AFTER_MULTI", "UNBALANCED", "LAST"}) {
+        dotenv::unset(key);
+    }
+}
+
+TEST_F(DotenvTest, BackendsAgreeOnMultilineValues) {
+    // Long lines push the quoted values across several 32-byte vectors
+    const std::string padding(100, 'x');
+    std::ofstream env_file(parser_test_file, std::ios::trunc);
+    env_file << "export BACKEND_KEY1=" << padding << " # comment\n";
+    env_file << "BACKEND_KEY2=\"" << padding << "\n" << padding << "\"\n";
+    env_file << "BACKEND_KEY3='a\nb' # comment\n";
+    env_file.close();
+
+    const auto load_with = [this](dotenv::parse_backend backend) {
+        return dotenv::load_legacy(
+            parser_test_file.string(),
+            {.apply_to_process = dotenv::process_env_apply::no,
+             .backend = backend});
+    };
+    const char *keys[] = {"BACKEND_KEY1", "BACKEND_KEY2", "BACKEND_KEY3"};
+    const std::string expected[] = {padding, padding + "\n" + padding,
+                                    "a\nb"};
+
+    // The simd backend falls back to the traditional one without AVX2
+    int traditional_count = 0;
+    for (const auto backend :
+         {dotenv::parse_backend::traditional, dotenv::parse_backend::simd}) {
+        auto [error, count] = load_with(backend);
+        ASSERT_EQ(error, dotenv::dotenv_error::success);
+        if (backend == dotenv::parse_backend::traditional) {
+            traditional_count = count;
+        }
+        EXPECT_EQ(count, traditional_count);
+        for (size_t i = 0; i < std::size(keys); ++i) {
+            EXPECT_EQ(dotenv::value(keys[i]), expected[i]) << keys[i];
+            dotenv::unset(keys[i]);
+        }
+    }
+
+#ifdef DOTENV_SIMD_ENABLED
+    auto mapped = dotenv::simd::load_simd_mmap(parser_test_file.string());
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_EQ(mapped->at("BACKEND_KEY2"), expected[1]);
+#endif
+}
+
 TEST_F(DotenvTest, OptionalAPI) {
     // Testar try_value com valores existentes
     dotenv::set("OPTIONAL_INT", "42");
@@ -248,3 +331,48 @@ TEST_F(DotenvTest, UnsetOperation) {
     // Verificar que retorna valor padrão após unset
     EXPECT_EQ(dotenv::value("UNSET_TEST", "default"), "default");
 }
+
+TEST_F(DotenvTest, ConcurrentWritersAcrossShards) {
+    constexpr int thread_count = 8;
+    constexpr int keys_per_thread = 200;
+    const std::string prefix = test_prefix + "SHARD_";
+
+    std::vector<std::thread> writers;
+    writers.reserve(thread_count);
+    for (int t = 0; t < thread_count; ++t) {
+        writers.emplace_back([&prefix, t]() {
+            for (int i = 0; i < keys_per_thread; ++i) {
+                auto suffix = std::to_string(t) + "_" + std::to_string(i);
+                dotenv::set(prefix + suffix, "value_" + suffix);
+            }
+        });
+    }
+    for (auto &writer : writers) {
+        writer.join();
+    }
+
+    // Enumeration sees every key written by every thread
+    struct match_state {
+        std::string prefix;
+        int matches{};
+    } state{prefix, 0};
+    dotenv_enumerate(
+        [](const char *key, const char * /*value*/, void *user_data) {
+            auto *st = static_cast<match_state *>(user_data);
+            if (std::string_view(key).starts_with(st->prefix)) {
+                ++st->matches;
+            }
+            return 0;
+        },
+        &state);
+    EXPECT_EQ(state.matches, thread_count * keys_per_thread);
+    EXPECT_EQ(dotenv::value(prefix + "7_199"), "value_7_199");
+
+    for (int t = 0; t < thread_count; ++t) {
+        for (int i = 0; i < keys_per_thread; ++i) {
+            dotenv::unset(prefix + std::to_string(t) + "_" +
+                          std::to_string(i));
+        }
+    }
+    EXPECT_FALSE(dotenv::contains(prefix + "0_0"));
+}
@@ -0,0 +1,126 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+class BudgetTest : public TempDirTest {
+  protected:
+    BudgetTest()
+        : TempDirTest("budget",
+                      {"BUDGET_A", "BUDGET_B", "BUDGET_C", "BUDGET_BIG",
+                       "BUDGET_LAYER", "BUDGET_LOCAL"}) {
+        for (int level = 0; level <= 6; ++level) {
+            track_key("BUDGET_L" + std::to_string(level));
+        }
+    }
+
+    static auto internal(dotenv::load_budget budget) -> dotenv::load_options {
+        auto options = TempDirTest::internal();
+        options.budget = budget;
+        return options;
+    }
+};
+
+TEST_F(BudgetTest, LineBudgetAbortsWithoutPartialCommit) {
+    const auto path =
+        env_file("lines.env", "BUDGET_A=1\nBUDGET_B=2\nBUDGET_C=3\n");
+
+    for (auto backend : {dotenv::parse_backend::auto_detect,
+                         dotenv::parse_backend::traditional}) {
+        auto options = internal({.max_lines = 2});
+        options.backend = backend;
+        EXPECT_EQ(dotenv::load_legacy(path, options).first,
+                  dotenv::dotenv_error::limit_exceeded);
+        EXPECT_FALSE(dotenv::contains("BUDGET_A"));
+    }
+    EXPECT_EQ(dotenv::load_with_report(path, internal({.max_lines = 2})).first,
+              dotenv::dotenv_error::limit_exceeded);
+
+    auto [error, count] = dotenv::load_legacy(path, internal({.max_lines = 3}));
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(count, 3);
+
+    // reload() acima do orçamento mantém o que já estava no store
+    env_file("lines.env", "BUDGET_A=changed\nBUDGET_B=2\nBUDGET_C=3\n");
+    EXPECT_EQ(dotenv::reload(path, internal({.max_lines = 1})).first,
+              dotenv::dotenv_error::limit_exceeded);
+    EXPECT_EQ(dotenv::value("BUDGET_A"), "1");
+}
+
+TEST_F(BudgetTest, MemoryBudgetCountsKeysAndValues) {
+    const auto path = env_file(
+        "big.env", "BUDGET_A=1\nBUDGET_BIG=" + std::string(1000, 'x') + "\n");
+
+    EXPECT_EQ(dotenv::load_legacy(path, internal({.max_memory = 512})).first,
+              dotenv::dotenv_error::limit_exceeded);
+    EXPECT_FALSE(dotenv::contains("BUDGET_A"));
+
+    ASSERT_EQ(dotenv::load_legacy(path, internal({.max_memory = 2048})).first,
+              dotenv::dotenv_error::success);
+    EXPECT_EQ(dotenv::value("BUDGET_BIG").size(), 1000U);
+}
+
+TEST_F(BudgetTest, ExpiredDeadlineStopsTheParse) {
+    std::string content;
+    for (int i = 0; i < 4096; ++i) {
+        content += "# comment line " + std::to_string(i) + "\n";
+    }
+    const auto path = env_file("slow.env", content + "BUDGET_A=1\n");
+
+    EXPECT_EQ(dotenv::load_legacy(
+                  path, internal({.max_duration = std::chrono::nanoseconds(1)}))
+                  .first,
+              dotenv::dotenv_error::limit_exceeded);
+    EXPECT_FALSE(dotenv::contains("BUDGET_A"));
+
+    ASSERT_EQ(dotenv::load_legacy(
+                  path, internal({.max_duration = std::chrono::minutes(1)}))
+                  .first,
+              dotenv::dotenv_error::success);
+    EXPECT_EQ(dotenv::value("BUDGET_A"), "1");
+}
+
+TEST_F(BudgetTest, MemoryBudgetStopsAnExpansionBomb) {
+    // Cada nível repete o anterior 8 vezes: BUDGET_L6 teria ~2,6 MB
+    std::string content = "BUDGET_L0=" + std::string(10, 'x') + "\n";
+    for (int level = 1; level <= 6; ++level) {
+        content += "BUDGET_L" + std::to_string(level) + "=";
+        for (int copy = 0; copy < 8; ++copy) {
+            content += "${BUDGET_L" + std::to_string(level - 1) + "}";
+        }
+        content += "\n";
+    }
+    const auto path = env_file("bomb.env", content);
+
+    auto options = internal({.max_memory = 64 * 1024});
+    options.expansion = dotenv::interpolation::eager;
+    EXPECT_EQ(dotenv::load_legacy(path, options).first,
+              dotenv::dotenv_error::limit_exceeded);
+    EXPECT_FALSE(dotenv::contains("BUDGET_L0"));
+    EXPECT_FALSE(dotenv::contains("BUDGET_L1"));
+}
+
+TEST_F(BudgetTest, LayersShareOneBudget) {
+    const auto base =
+        env_file("base.env", "BUDGET_LAYER=base\nBUDGET_A=1\nBUDGET_B=2\n");
+    const auto local =
+        env_file("local.env", "BUDGET_LAYER=local\nBUDGET_LOCAL=1\n");
+
+    for (bool parallel : {false, true}) {
+        auto options = internal({.max_lines = 4});
+        options.parallel_parse = parallel;
+        EXPECT_EQ(dotenv::load_layers({base, local}, options).first,
+                  dotenv::dotenv_error::limit_exceeded);
+        EXPECT_FALSE(dotenv::contains("BUDGET_LAYER"));
+        EXPECT_FALSE(dotenv::contains("BUDGET_A"));
+    }
+
+    ASSERT_EQ(
+        dotenv::load_layers({base, local}, internal({.max_lines = 5})).first,
+        dotenv::dotenv_error::success);
+    EXPECT_EQ(dotenv::value("BUDGET_LAYER"), "local");
+}
@@ -0,0 +1,116 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <unistd.h>
+
+class CompiledTest : public TempDirTest {
+  protected:
+    CompiledTest() : TempDirTest("compiled", {}) {}
+
+    void SetUp() override {
+        TempDirTest::SetUp();
+        env_file_ = test_dir_ / "app.env";
+        image_file_ = test_dir_ / "app.envc";
+    }
+
+    auto compile(const std::string &content,
+                 const dotenv::load_options &options = {}) const
+        -> dotenv::compiled_env {
+        write_file(env_file_, content);
+        EXPECT_EQ(dotenv::compile(env_file_.string(), image_file_.string(),
+                                  options),
+                  dotenv::dotenv_error::success);
+        auto [error, env] = dotenv::load_compiled(image_file_.string());
+        EXPECT_EQ(error, dotenv::dotenv_error::success);
+        return env;
+    }
+
+    std::filesystem::path env_file_;
+    std::filesystem::path image_file_;
+};
+
+TEST_F(CompiledTest, ServesLookupsFromTheImage) {
+    auto env = compile("# comment\nIMG_HOST=db.local\nIMG_PORT=5432\n"
+                       "IMG_EMPTY=\n"
+                       "IMG_PEM=\"-----BEGIN-----\nabc\n-----END-----\"\n"
+                       "IMG_HOST=replica.local\n");
+    EXPECT_EQ(env.size(), 4U);
+    EXPECT_EQ(env.get("IMG_HOST"), "replica.local");
+    EXPECT_EQ(env.get("IMG_PORT"), "5432");
+    EXPECT_EQ(env.get("IMG_PEM"), "-----BEGIN-----\nabc\n-----END-----");
+    EXPECT_TRUE(env.contains("IMG_EMPTY"));
+    EXPECT_FALSE(env.contains("MISSING"));
+    EXPECT_EQ(env.get("MISSING", "fallback"), "fallback");
+
+    // Values are NUL-terminated inside the mapping
+    auto port = env.find("IMG_PORT");
+    ASSERT_TRUE(port.has_value());
+    EXPECT_EQ(port->data()[port->size()], '\0');
+
+    // The store is not involved
+    EXPECT_FALSE(dotenv::contains("IMG_PORT"));
+}
+
+TEST_F(CompiledTest, FindsEveryKeyOfALargeImage) {
+    std::string content;
+    for (int i = 0; i < 5000; ++i) {
+        content += "KEY_" + std::to_string(i) + "=value_" + std::to_string(i) +
+                   "\n";
+    }
+    auto env = compile(content);
+    ASSERT_EQ(env.size(), 5000U);
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(env.get("KEY_" + std::to_string(i)),
+                  "value_" + std::to_string(i));
+    }
+
+    std::map<std::string, std::string> visited;
+    std::string previous;
+    env.for_each([&](std::string_view key, std::string_view value) {
+        EXPECT_LT(previous, key);
+        previous = key;
+        visited.emplace(key, value);
+    });
+    EXPECT_EQ(visited.size(), 5000U);
+}
+
+TEST_F(CompiledTest, ExpandsReferencesAtCompileTime) {
+    auto env = compile("IMG_HOST=db\n"
+                       "IMG_URL=pg://${IMG_HOST}:${IMG_PORT:-5432}\n",
+                       {.expansion = dotenv::interpolation::lazy});
+    EXPECT_EQ(env.get("IMG_URL"), "pg://db:5432");
+}
+
+TEST_F(CompiledTest, EmptySourceCompilesToEmptyImage) {
+    auto env = compile("# only comments\n");
+    EXPECT_EQ(env.size(), 0U);
+    EXPECT_FALSE(env.find("ANY").has_value());
+}
+
+TEST_F(CompiledTest, RejectsCorruptImages) {
+    auto env = compile("IMG_HOST=db\nIMG_PORT=5432\n");
+    const auto source_hash = env.source_hash();
+    EXPECT_NE(source_hash, 0U);
+
+    const auto image_size = std::filesystem::file_size(image_file_);
+    std::filesystem::resize_file(image_file_, image_size - 1);
+    EXPECT_EQ(dotenv::load_compiled(image_file_.string()).first,
+              dotenv::dotenv_error::invalid_format);
+
+    {
+        std::ofstream file(image_file_, std::ios::trunc);
+        file << "IMG_HOST=db\nnot an image, just text longer than a header\n";
+    }
+    EXPECT_EQ(dotenv::load_compiled(image_file_.string()).first,
+              dotenv::dotenv_error::invalid_format);
+
+    EXPECT_EQ(dotenv::load_compiled((test_dir_ / "missing").string()).first,
+              dotenv::dotenv_error::file_not_found);
+    EXPECT_EQ(dotenv::compile((test_dir_ / "missing.env").string(),
+                              image_file_.string()),
+              dotenv::dotenv_error::file_not_found);
+}
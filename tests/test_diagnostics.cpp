@@ -0,0 +1,100 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+class DiagnosticsTest : public TempDirTest {
+  protected:
+    struct reported {
+        std::string file;
+        size_t line;
+        size_t column;
+        dotenv::diagnostic_code code;
+    };
+
+    DiagnosticsTest()
+        : TempDirTest("diagnostics",
+                      {"DIAG_A", "DIAG_B", "DIAG_BIG", "DIAG_LAYER"}) {}
+
+    auto options() -> dotenv::load_options {
+        auto options = internal();
+        options.on_diagnostic = [this](const dotenv::diagnostic &issue) {
+            issues_.push_back({std::string(issue.file), issue.line,
+                               issue.column, issue.code});
+        };
+        return options;
+    }
+
+    std::vector<reported> issues_;
+};
+
+TEST_F(DiagnosticsTest, ReportsEveryRejectedLineWithPosition) {
+    const auto path = env_file(
+        "bad.env", "DIAG_A=1\n"
+                   "  just text\n"
+                   "export 1BAD=x\n"
+                   "DIAG_LONG=" + std::string(9000, 'x') + "\n"
+                   "DIAG_BIG=" + std::string(5000, 'y') + "\n"
+                   "DIAG_B=2\n");
+
+    for (auto backend : {dotenv::parse_backend::auto_detect,
+                         dotenv::parse_backend::traditional}) {
+        issues_.clear();
+        auto load = options();
+        load.backend = backend;
+        ASSERT_EQ(dotenv::load_legacy(path, load).first,
+                  dotenv::dotenv_error::success);
+
+        ASSERT_EQ(issues_.size(), 4U);
+        EXPECT_EQ(issues_[0].file, path);
+        EXPECT_EQ(issues_[0].line, 2U);
+        EXPECT_EQ(issues_[0].column, 3U);
+        EXPECT_EQ(issues_[0].code,
+                  dotenv::diagnostic_code::missing_separator);
+        EXPECT_EQ(issues_[1].line, 3U);
+        EXPECT_EQ(issues_[1].column, 8U);
+        EXPECT_EQ(issues_[1].code, dotenv::diagnostic_code::invalid_key);
+        EXPECT_EQ(issues_[2].line, 4U);
+        EXPECT_EQ(issues_[2].code, dotenv::diagnostic_code::line_too_long);
+        EXPECT_EQ(issues_[3].line, 5U);
+        EXPECT_EQ(issues_[3].column, 10U);
+        EXPECT_EQ(issues_[3].code, dotenv::diagnostic_code::value_truncated);
+    }
+    EXPECT_EQ(dotenv::value("DIAG_B"), "2");
+}
+
+TEST_F(DiagnosticsTest, NothingIsWrittenToStderr) {
+    const auto path = env_file(
+        "long.env", "DIAG_LONG=" + std::string(9000, 'x') + "\nDIAG_A=1\n");
+
+    ::testing::internal::CaptureStderr();
+    ASSERT_EQ(dotenv::load_legacy(path, {.apply_to_process =
+                                             dotenv::process_env_apply::no})
+                  .first,
+              dotenv::dotenv_error::success);
+    EXPECT_EQ(::testing::internal::GetCapturedStderr(), "");
+    EXPECT_EQ(dotenv::value("DIAG_A"), "1");
+}
+
+TEST_F(DiagnosticsTest, LayersReportTheirOwnFile) {
+    const auto base = env_file("base.env", "DIAG_LAYER=base\nbroken\n");
+    const auto local = env_file("local.env", "\n\n=empty\nDIAG_LAYER=local\n");
+
+    auto load = options();
+    load.parallel_parse = true;
+    ASSERT_EQ(dotenv::load_layers({base, local}, load).first,
+              dotenv::dotenv_error::success);
+    ASSERT_EQ(issues_.size(), 2U);
+    const auto &first = (issues_[0].file == base) ? issues_[0] : issues_[1];
+    const auto &second = (issues_[0].file == base) ? issues_[1] : issues_[0];
+    EXPECT_EQ(first.line, 2U);
+    EXPECT_EQ(first.code, dotenv::diagnostic_code::missing_separator);
+    EXPECT_EQ(second.file, local);
+    EXPECT_EQ(second.line, 3U);
+    EXPECT_EQ(second.code, dotenv::diagnostic_code::invalid_key);
+    EXPECT_EQ(dotenv::value("DIAG_LAYER"), "local");
+}
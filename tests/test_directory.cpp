@@ -0,0 +1,81 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+class DirectoryTest : public TempDirTest {
+  protected:
+    DirectoryTest()
+        : TempDirTest("directory", {"DB_PASSWORD", "API_TOKEN", "TLS_CERT",
+                                    "EMPTY_SECRET", "EXISTING_SECRET"}) {}
+};
+
+// Layout of a Kubernetes Secret volume: keys are symlinks into a
+// timestamped directory reached through "..data"
+TEST_F(DirectoryTest, LoadsKubernetesSecretMount) {
+    const auto revision = test_dir_ / "..2026_10_18_12_00_00.000000001";
+    std::filesystem::create_directories(revision);
+    write_file(revision / "DB_PASSWORD", "s3cr=t\n");
+    write_file(revision / "API_TOKEN", "token-123");
+    std::filesystem::create_directory_symlink(revision.filename(),
+                                              test_dir_ / "..data");
+    for (const char *key : {"DB_PASSWORD", "API_TOKEN"}) {
+        std::filesystem::create_symlink(std::filesystem::path("..data") / key,
+                                        test_dir_ / key);
+    }
+
+    auto [error, count] = dotenv::load_directory(
+        test_dir_.string(), {.apply_to_process = dotenv::process_env_apply::no,
+                             .strip_trailing_newline = true});
+    EXPECT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(dotenv::value("DB_PASSWORD"), "s3cr=t");
+    EXPECT_EQ(dotenv::value("API_TOKEN"), "token-123");
+}
+
+TEST_F(DirectoryTest, KeepsContentsVerbatimByDefault) {
+    // Larger than the single-read limit, so the file is memory-mapped
+    std::string cert = "-----BEGIN CERTIFICATE-----\r\n";
+    cert += std::string(100 * 1024, 'A');
+    cert += "\r\n-----END CERTIFICATE-----\r\n";
+    write_file(test_dir_ / "TLS_CERT", cert);
+    write_file(test_dir_ / "EMPTY_SECRET", "");
+
+    auto [error, count] = dotenv::load_directory(test_dir_.string());
+    EXPECT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(dotenv::value("TLS_CERT"), cert);
+    EXPECT_TRUE(dotenv::contains("EMPTY_SECRET"));
+
+    const char *applied = std::getenv("TLS_CERT");
+    ASSERT_NE(applied, nullptr);
+    EXPECT_EQ(std::string(applied), cert);
+}
+
+TEST_F(DirectoryTest, RespectsPreservePolicy) {
+    dotenv::set("EXISTING_SECRET", "kept");
+    write_file(test_dir_ / "EXISTING_SECRET", "replaced");
+    write_file(test_dir_ / "API_TOKEN", "t");
+
+    auto [error, count] = dotenv::load_directory(
+        test_dir_.string(),
+        {.overwrite_policy = dotenv::overwrite::preserve,
+         .apply_to_process = dotenv::process_env_apply::no});
+    EXPECT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(dotenv::value("EXISTING_SECRET"), "kept");
+    EXPECT_EQ(dotenv::value("API_TOKEN"), "t");
+}
+
+TEST_F(DirectoryTest, ReportsMissingOrInvalidDirectory) {
+    EXPECT_EQ(dotenv::load_directory((test_dir_ / "missing").string()).first,
+              dotenv::dotenv_error::file_not_found);
+
+    write_file(test_dir_ / "API_TOKEN", "t");
+    EXPECT_EQ(dotenv::load_directory((test_dir_ / "API_TOKEN").string()).first,
+              dotenv::dotenv_error::invalid_argument);
+}
@@ -0,0 +1,191 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+class EnvironmentTest : public TempDirTest {
+  protected:
+    EnvironmentTest()
+        : TempDirTest("environment",
+                      {"ENVI_NAME", "ENVI_PORT", "ENVI_ONLY_A", "ENVI_ONLY_B",
+                       "ENVI_URL", "ENVI_DEFAULT"}) {}
+};
+
+TEST_F(EnvironmentTest, InstancesAreIsolated) {
+    const auto first =
+        env_file("a.env", "ENVI_NAME=alpha\nENVI_PORT=8080\nENVI_ONLY_A=1\n");
+    const auto second =
+        env_file("b.env", "ENVI_NAME=beta\nENVI_PORT=9090\nENVI_ONLY_B=1\n");
+
+    dotenv::environment alpha;
+    dotenv::environment beta;
+    ASSERT_EQ(alpha.load(first, internal()),
+              std::make_pair(dotenv::dotenv_error::success, 3));
+    ASSERT_EQ(beta.load(second, internal()),
+              std::make_pair(dotenv::dotenv_error::success, 3));
+
+    EXPECT_EQ(alpha.value("ENVI_NAME"), "alpha");
+    EXPECT_EQ(beta.value("ENVI_NAME"), "beta");
+    EXPECT_EQ(alpha.value_or<int>("ENVI_PORT", 0), 8080);
+    EXPECT_EQ(beta.value_or<int>("ENVI_PORT", 0), 9090);
+    EXPECT_EQ(alpha.value_or<int>("ENVI_NAME", -1), -1);
+    EXPECT_TRUE(alpha.contains("ENVI_ONLY_A"));
+    EXPECT_FALSE(alpha.contains("ENVI_ONLY_B"));
+    EXPECT_FALSE(beta.try_value("ENVI_ONLY_A").has_value());
+
+    // Nada vaza para o ambiente padrão
+    EXPECT_FALSE(dotenv::contains("ENVI_NAME"));
+    EXPECT_EQ(dotenv::get("ENVI_PORT", "none"), "none");
+
+    alpha.clear();
+    EXPECT_FALSE(alpha.contains("ENVI_NAME"));
+    EXPECT_EQ(beta.value("ENVI_NAME"), "beta");
+}
+
+TEST_F(EnvironmentTest, SetUnsetAndEntriesStayLocal) {
+    dotenv::environment env;
+    env.set("ENVI_NAME", "local");
+    env.set("ENVI_NAME", "ignored", dotenv::overwrite::preserve);
+    env.set("ENVI_PORT", "1");
+    EXPECT_EQ(env.get("ENVI_NAME"), "local");
+    EXPECT_FALSE(dotenv::contains("ENVI_NAME"));
+
+    env.unset("ENVI_PORT");
+    EXPECT_FALSE(env.contains("ENVI_PORT"));
+
+    std::map<std::string, std::string> listed;
+    for (const auto &[key, value] : env.entries()) {
+        listed.emplace(key, value);
+    }
+    EXPECT_EQ(listed, (std::map<std::string, std::string>{
+                          {"ENVI_NAME", "local"}}));
+
+    // A instância ainda enxerga o ambiente do processo como as funções livres
+    ::setenv("ENVI_DEFAULT", "process", 1);
+    EXPECT_EQ(env.value("ENVI_DEFAULT"), "process");
+}
+
+TEST_F(EnvironmentTest, SaveToFileWritesOnlyThisInstance) {
+    dotenv::set("ENVI_DEFAULT", "global");
+    dotenv::environment env;
+    env.set("ENVI_URL", "localhost");
+    env.set("ENVI_PORT", "5432");
+
+    const auto path = (test_dir_ / "saved.env").string();
+    env.save_to_file(path, {.sorted = true});
+    EXPECT_EQ(read_file(path), "ENVI_PORT=5432\nENVI_URL=localhost\n");
+
+    dotenv::environment reloaded;
+    ASSERT_EQ(reloaded.load(path, internal()).first,
+              dotenv::dotenv_error::success);
+    EXPECT_EQ(reloaded.value("ENVI_URL"), "localhost");
+    EXPECT_FALSE(reloaded.contains("ENVI_DEFAULT"));
+}
+
+TEST_F(EnvironmentTest, DefaultEnvironmentBacksTheFreeFunctions) {
+    auto &env = dotenv::default_environment();
+    EXPECT_EQ(&env, &dotenv::default_environment());
+
+    dotenv::set("ENVI_DEFAULT", "free");
+    EXPECT_EQ(env.value("ENVI_DEFAULT"), "free");
+    env.set("ENVI_NAME", "member");
+    EXPECT_EQ(dotenv::value("ENVI_NAME"), "member");
+
+    const auto path = env_file("default.env", "ENVI_PORT=7\n");
+    ASSERT_EQ(env.load(path, internal()).first, dotenv::dotenv_error::success);
+    EXPECT_EQ(dotenv::value_or<int>("ENVI_PORT", 0), 7);
+}
+
+TEST_F(EnvironmentTest, FailedLoadLeavesTheInstanceUntouched) {
+    dotenv::environment env;
+    env.set("ENVI_NAME", "before");
+    const auto path =
+        env_file("bad.env", "ENVI_NAME=after\nnot a line\nENVI_PORT=1\n");
+
+    auto options = internal();
+    options.strict = true;
+    EXPECT_EQ(env.load(path, options).first,
+              dotenv::dotenv_error::invalid_format);
+
+    options = internal();
+    options.budget.max_lines = 1;
+    EXPECT_EQ(env.load(path, options).first,
+              dotenv::dotenv_error::limit_exceeded);
+
+    EXPECT_EQ(env.value("ENVI_NAME"), "before");
+    EXPECT_FALSE(env.contains("ENVI_PORT"));
+}
+
+TEST_F(EnvironmentTest, SkipIfUnchangedIsTrackedPerInstance) {
+    const auto path = env_file("same.env", "ENVI_NAME=tracked\n");
+    auto options = internal();
+    options.skip_if_unchanged = true;
+
+    dotenv::environment first;
+    ASSERT_EQ(first.load(path, options).second, 1);
+    first.unset("ENVI_NAME");
+    // Arquivo igual: a carga é pulada e a chave removida não volta
+    ASSERT_EQ(first.load(path, options).second, 1);
+    EXPECT_FALSE(first.contains("ENVI_NAME"));
+
+    // Outra instância nunca carregou o arquivo
+    dotenv::environment second;
+    ASSERT_EQ(second.load(path, options).second, 1);
+    EXPECT_EQ(second.value("ENVI_NAME"), "tracked");
+}
+
+TEST_F(EnvironmentTest, LayersDirectoriesAndPrefixesStayLocal) {
+    const auto base = env_file("base.env", "ENVI_NAME=base\nENVI_PORT=1\n");
+    const auto local = env_file(
+        "local.env", "ENVI_PORT=2\nENVI_URL=${ENVI_NAME}:${ENVI_PORT}\n");
+    const auto secrets = test_dir_ / "secrets";
+    std::filesystem::create_directories(secrets);
+    std::ofstream(secrets / "ENVI_ONLY_A") << "from_directory";
+
+    auto options = internal();
+    options.expansion = dotenv::interpolation::eager;
+    dotenv::environment env;
+    ASSERT_EQ(env.load_layers({base, local}, options).second, 3);
+    ASSERT_EQ(env.load_directory(secrets.string(), internal()).second, 1);
+
+    EXPECT_EQ(env.value("ENVI_URL"), "base:2");
+    EXPECT_EQ(env.value("ENVI_ONLY_A"), "from_directory");
+    std::map<std::string, std::string> prefixed;
+    for (auto [key, value] : env.entries_with_prefix("ENVI_ONLY_")) {
+        prefixed.emplace(key, value);
+    }
+    EXPECT_EQ(prefixed, (std::map<std::string, std::string>{
+                            {"ENVI_ONLY_A", "from_directory"}}));
+
+    // Nada chegou ao store padrão
+    EXPECT_FALSE(dotenv::contains("ENVI_NAME"));
+    EXPECT_FALSE(dotenv::contains("ENVI_ONLY_A"));
+    EXPECT_TRUE(dotenv::entries_with_prefix("ENVI_").empty());
+}
+
+TEST_F(EnvironmentTest, WithoutFallbackTheProcessEnvironmentIsIgnored) {
+    ::setenv("ENVI_DEFAULT", "from_process", 1);
+    const auto path = env_file("tenant.env", "ENVI_NAME=tenant\n"
+                                             "ENVI_URL=${ENVI_DEFAULT}/x\n");
+
+    dotenv::environment env(dotenv::process_env_fallback::no);
+    // apply_to_process::yes (o padrão) não tem efeito nesta instância
+    ASSERT_EQ(
+        env.load(path, {.expansion = dotenv::interpolation::eager}).second, 2);
+
+    EXPECT_EQ(env.value("ENVI_URL"), "/x");
+    EXPECT_FALSE(env.contains("ENVI_DEFAULT"));
+    EXPECT_EQ(env.get("ENVI_DEFAULT", "none"), "none");
+    EXPECT_FALSE(env.try_value("ENVI_DEFAULT").has_value());
+    EXPECT_EQ(std::getenv("ENVI_NAME"), nullptr);
+
+    // Com o fallback padrão a mesma consulta chega ao processo
+    dotenv::environment shared;
+    EXPECT_EQ(shared.value("ENVI_DEFAULT"), "from_process");
+}
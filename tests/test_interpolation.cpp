@@ -0,0 +1,224 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+class InterpolationTest : public TempDirTest {
+  protected:
+    InterpolationTest()
+        : TempDirTest("interpolation",
+                      {"HOST", "PORT", "URL", "SHORT", "FALLBACK", "NESTED",
+                       "EMPTY", "FIRST", "SECOND", "LOOP_A", "LOOP_B", "AFTER",
+                       "QUOTED", "ESCAPED", "STORED", "FROM_STORE", "FROM_ENV",
+                       "SEARCH_PATH", "DOTENV_INTERP_PROCESS"}) {}
+
+    void SetUp() override {
+        TempDirTest::SetUp();
+        env_file_ = test_dir_ / "app.env";
+    }
+
+    auto load(const std::string &content,
+              dotenv::interpolation expansion = dotenv::interpolation::eager,
+              dotenv::parse_backend backend =
+                  dotenv::parse_backend::auto_detect) const -> int {
+        write_file(env_file_, content);
+        auto options = internal();
+        options.backend = backend;
+        options.expansion = expansion;
+        auto [error, count] = dotenv::load_legacy(env_file_.string(), options);
+        EXPECT_EQ(error, dotenv::dotenv_error::success);
+        return count;
+    }
+
+    std::filesystem::path env_file_;
+};
+
+TEST_F(InterpolationTest, ExpandsBracedAndBareReferences) {
+    EXPECT_EQ(load("HOST=db.local\nPORT=5432\n"
+                   "URL=postgres://${HOST}:$PORT/app\nSHORT=$HOST-x\n"),
+              4);
+    EXPECT_EQ(dotenv::value("URL"), "postgres://db.local:5432/app");
+    EXPECT_EQ(dotenv::value("SHORT"), "db.local-x");
+}
+
+TEST_F(InterpolationTest, ResolvesForwardReferences) {
+    load("URL=http://${HOST}:${PORT}\nHOST=example.com\nPORT=${SECOND}\n"
+         "SECOND=8080\n");
+    EXPECT_EQ(dotenv::value("URL"), "http://example.com:8080");
+}
+
+TEST_F(InterpolationTest, UsesDefaultsForUnsetOrEmpty) {
+    load("EMPTY=\nFALLBACK=${MISSING_DOTENV_VAR:-none}\n"
+         "NESTED=${EMPTY:-${HOST:-localhost}}:${PORT:-80}\nPORT=81\n");
+    EXPECT_EQ(dotenv::value("FALLBACK"), "none");
+    EXPECT_EQ(dotenv::value("NESTED"), "localhost:81");
+}
+
+TEST_F(InterpolationTest, FallsBackToStoreThenProcessEnvironment) {
+    dotenv::set("STORED", "from-store");
+    ::setenv("DOTENV_INTERP_PROCESS", "from-env", 1);
+
+    load("FROM_STORE=${STORED}\nFROM_ENV=${DOTENV_INTERP_PROCESS}\n"
+         "EMPTY=[${MISSING_DOTENV_VAR}]\n");
+    EXPECT_EQ(dotenv::value("FROM_STORE"), "from-store");
+    EXPECT_EQ(dotenv::value("FROM_ENV"), "from-env");
+    EXPECT_EQ(dotenv::value("EMPTY"), "[]");
+}
+
+TEST_F(InterpolationTest, SelfReferenceSeesPreviousValue) {
+    dotenv::set("SEARCH_PATH", "/usr/bin");
+    load("SEARCH_PATH=${SEARCH_PATH}:/opt/bin\n");
+    EXPECT_EQ(dotenv::value("SEARCH_PATH"), "/usr/bin:/opt/bin");
+}
+
+TEST_F(InterpolationTest, CyclesExpandToEmpty) {
+    load("LOOP_A=a${LOOP_B}\nLOOP_B=b${LOOP_A}\nAFTER=${LOOP_A:-unset}\n");
+    const auto first = dotenv::value("LOOP_A");
+    const auto second = dotenv::value("LOOP_B");
+    // The entry where the cycle was entered keeps the other side's text
+    EXPECT_TRUE((first == "ab" && second == "b") ||
+                (first == "a" && second == "ba"))
+        << first << " / " << second;
+    EXPECT_FALSE(dotenv::value("AFTER").empty());
+}
+
+TEST_F(InterpolationTest, OverlyDeepChainsFailTheLoad) {
+    // CHAIN_0 -> CHAIN_1 -> ... -> CHAIN_n=end, written in both orders so the
+    // outcome cannot depend on which key the expansion starts from
+    const auto chain = [](int length, bool reversed) {
+        std::string content;
+        for (int i = 0; i < length; ++i) {
+            const int index = reversed ? length - 1 - i : i;
+            const auto next = "${CHAIN_" + std::to_string(index + 1) + "}";
+            content += "CHAIN_" + std::to_string(index) + "=" +
+                       (index + 1 == length ? std::string("end") : next) +
+                       "\n";
+        }
+        return content;
+    };
+    const auto load_chain = [&](int length, bool reversed) {
+        {
+            std::ofstream file(env_file_, std::ios::trunc);
+            file << chain(length, reversed);
+        }
+        return dotenv::load_legacy(
+                   env_file_.string(),
+                   {.apply_to_process = dotenv::process_env_apply::no,
+                    .expansion = dotenv::interpolation::eager})
+            .first;
+    };
+
+    for (const bool reversed : {false, true}) {
+        EXPECT_EQ(load_chain(300, reversed),
+                  dotenv::dotenv_error::limit_exceeded);
+        EXPECT_FALSE(dotenv::snapshot{}.contains("CHAIN_0"));
+
+        ASSERT_EQ(load_chain(200, reversed), dotenv::dotenv_error::success);
+        EXPECT_EQ(dotenv::value("CHAIN_0"), "end");
+        for (int i = 0; i < 200; ++i) {
+            dotenv::unset("CHAIN_" + std::to_string(i));
+        }
+    }
+}
+
+TEST_F(InterpolationTest, SingleQuotesAndEscapesStayLiteral) {
+    load("HOST=db\nQUOTED='${HOST}'\nESCAPED=\\${HOST} costs \\$5\n");
+    EXPECT_EQ(dotenv::value("QUOTED"), "${HOST}");
+    EXPECT_EQ(dotenv::value("ESCAPED"), "${HOST} costs $5");
+}
+
+TEST_F(InterpolationTest, DisabledByDefault) {
+    load("HOST=db\nURL=${HOST}/x\n", dotenv::interpolation::none);
+    EXPECT_EQ(dotenv::value("URL"), "${HOST}/x");
+}
+
+TEST_F(InterpolationTest, BackendsShareExpansion) {
+    load("HOST=db\nURL=${HOST}/x\n", dotenv::interpolation::eager,
+         dotenv::parse_backend::traditional);
+    EXPECT_EQ(dotenv::value("URL"), "db/x");
+    dotenv::unset("URL");
+
+    load("HOST=db2\nURL=${HOST}/y\n", dotenv::interpolation::eager,
+         dotenv::parse_backend::simd);
+    EXPECT_EQ(dotenv::value("URL"), "db2/y");
+}
+
+TEST_F(InterpolationTest, ReloadExpandsReferences) {
+    {
+        std::ofstream file(env_file_, std::ios::trunc);
+        file << "HOST=cache\nURL=redis://${HOST}\n";
+    }
+    auto [error, changes] = dotenv::reload(
+        env_file_.string(), {.apply_to_process = dotenv::process_env_apply::no,
+                             .expansion = dotenv::interpolation::eager});
+    EXPECT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(changes.added.size(), 2U);
+    EXPECT_EQ(dotenv::value("URL"), "redis://cache");
+}
+
+TEST_F(InterpolationTest, LazyExpandsOnReadAndTracksDependencies) {
+    load("URL=${HOST}:${SECOND}\nHOST=${FIRST}\nFIRST=db\nSECOND=5432\n",
+         dotenv::interpolation::lazy);
+    EXPECT_EQ(dotenv::value("URL"), "db:5432");
+    EXPECT_EQ(dotenv::get("URL"), "db:5432");
+
+    // Transitive invalidation through HOST
+    dotenv::set("FIRST", "replica");
+    EXPECT_EQ(dotenv::value("URL"), "replica:5432");
+    dotenv::unset("SECOND");
+    EXPECT_EQ(dotenv::value("URL"), "replica:");
+
+    // A plain set() replaces the template
+    dotenv::set("HOST", "${FIRST}");
+    EXPECT_EQ(dotenv::value("URL"), "${FIRST}:");
+}
+
+TEST_F(InterpolationTest, LazyMatchesEagerSemantics) {
+    dotenv::set("SEARCH_PATH", "/usr/bin");
+    load("SEARCH_PATH=${SEARCH_PATH}:/opt/bin\nQUOTED='${SEARCH_PATH}'\n"
+         "ESCAPED=\\$HOST\nLOOP_A=a${LOOP_B}\nLOOP_B=b${LOOP_A}\n"
+         "FALLBACK=${MISSING_DOTENV_VAR:-${QUOTED}}\n",
+         dotenv::interpolation::lazy);
+    EXPECT_EQ(dotenv::value("SEARCH_PATH"), "/usr/bin:/opt/bin");
+    EXPECT_EQ(dotenv::value("SEARCH_PATH"), "/usr/bin:/opt/bin");
+    EXPECT_EQ(dotenv::value("QUOTED"), "${SEARCH_PATH}");
+    EXPECT_EQ(dotenv::value("ESCAPED"), "$HOST");
+    EXPECT_EQ(dotenv::value("FALLBACK"), "${SEARCH_PATH}");
+    EXPECT_EQ(dotenv::value("LOOP_A"), "ab");
+}
+
+TEST_F(InterpolationTest, LazySnapshotExpandsAgainstPinnedState) {
+    load("HOST=db\nURL=${HOST}/x\n", dotenv::interpolation::lazy);
+    dotenv::snapshot before;
+    dotenv::set("HOST", "db2");
+
+    EXPECT_EQ(before.get("URL"), "db/x");
+    EXPECT_EQ(dotenv::snapshot{}.get("URL"), "db2/x");
+    EXPECT_EQ(dotenv::value("URL"), "db2/x");
+}
+
+TEST_F(InterpolationTest, LazyReloadInvalidatesChangedInputs) {
+    auto reload = [this](const std::string &content) {
+        {
+            std::ofstream file(env_file_, std::ios::trunc);
+            file << content;
+        }
+        return dotenv::reload(
+            env_file_.string(),
+            {.apply_to_process = dotenv::process_env_apply::no,
+             .expansion = dotenv::interpolation::lazy});
+    };
+
+    reload("HOST=cache\nURL=redis://${HOST}\n");
+    EXPECT_EQ(dotenv::value("URL"), "redis://cache");
+
+    auto [error, changes] = reload("HOST=cache2\nURL=redis://${HOST}\n");
+    EXPECT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(changes.changed, std::vector<std::string>{"HOST"});
+    EXPECT_EQ(dotenv::value("URL"), "redis://cache2");
+}
@@ -0,0 +1,100 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+class LayersTest : public TempDirTest {
+  protected:
+    LayersTest()
+        : TempDirTest("layers",
+                      {"LAYER_HOST", "LAYER_PORT", "LAYER_DEBUG", "LAYER_URL",
+                       "LAYER_PATH", "LAYER_ONLY_LOCAL", "LAYER_EXISTING"}) {}
+};
+
+TEST_F(LayersTest, LaterLayersTakePrecedence) {
+    const std::vector<std::string> paths = {
+        env_file(".env",
+                 "LAYER_HOST=localhost\nLAYER_PORT=80\nLAYER_DEBUG=1\n"),
+        env_file(".env.production", "LAYER_HOST=prod.example.com\n"
+                                    "LAYER_DEBUG=0\n"),
+        env_file(".env.local", "LAYER_DEBUG=2\nLAYER_ONLY_LOCAL=yes\n")};
+
+    for (bool parallel : {false, true}) {
+        auto [error, count] = dotenv::load_layers(
+            paths, {.apply_to_process = dotenv::process_env_apply::no,
+                    .parallel_parse = parallel});
+        EXPECT_EQ(error, dotenv::dotenv_error::success);
+        EXPECT_EQ(count, 4);
+        EXPECT_EQ(dotenv::value("LAYER_HOST"), "prod.example.com");
+        EXPECT_EQ(dotenv::value("LAYER_PORT"), "80");
+        EXPECT_EQ(dotenv::value("LAYER_DEBUG"), "2");
+        EXPECT_EQ(dotenv::value("LAYER_ONLY_LOCAL"), "yes");
+    }
+}
+
+TEST_F(LayersTest, CommitsOnceAndAppliesOnlyMergedKeys) {
+    dotenv::set("LAYER_EXISTING", "internal");
+    const auto before = dotenv::snapshot{}.generation();
+
+    auto [error, count] = dotenv::load_layers(
+        {env_file(".env", "LAYER_HOST=a\nLAYER_PORT=1\n"),
+         env_file(".env.local", "LAYER_HOST=b\n")});
+    EXPECT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(dotenv::snapshot{}.generation(), before + 1);
+
+    const char *host = std::getenv("LAYER_HOST");
+    ASSERT_NE(host, nullptr);
+    EXPECT_STREQ(host, "b");
+    EXPECT_EQ(std::getenv("LAYER_EXISTING"), nullptr);
+}
+
+TEST_F(LayersTest, MissingLayersAreOptional) {
+    auto [error, count] = dotenv::load_layers(
+        {env_file(".env", "LAYER_HOST=a\n"),
+         (test_dir_ / ".env.local").string()},
+        {.apply_to_process = dotenv::process_env_apply::no});
+    EXPECT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(count, 1);
+
+    auto [missing, none] =
+        dotenv::load_layers({(test_dir_ / "nothing.env").string()});
+    EXPECT_EQ(missing, dotenv::dotenv_error::file_not_found);
+    EXPECT_EQ(none, 0);
+}
+
+TEST_F(LayersTest, PreservePolicyKeepsExistingKeys) {
+    dotenv::set("LAYER_EXISTING", "kept");
+    dotenv::load_layers(
+        {env_file(".env", "LAYER_EXISTING=base\nLAYER_HOST=a\n"),
+         env_file(".env.local", "LAYER_EXISTING=local\n")},
+        {.overwrite_policy = dotenv::overwrite::preserve,
+         .apply_to_process = dotenv::process_env_apply::no});
+    EXPECT_EQ(dotenv::value("LAYER_EXISTING"), "kept");
+    EXPECT_EQ(dotenv::value("LAYER_HOST"), "a");
+}
+
+TEST_F(LayersTest, ReferencesResolveAcrossLayers) {
+    const std::vector<std::string> paths = {
+        env_file(".env", "LAYER_HOST=db\nLAYER_PATH=/usr/bin\n"),
+        env_file(".env.local",
+                 "LAYER_URL=pg://${LAYER_HOST}:${LAYER_PORT:-5432}\n"
+                 "LAYER_PATH=${LAYER_PATH}:/opt/bin\n")};
+
+    for (auto expansion :
+         {dotenv::interpolation::eager, dotenv::interpolation::lazy}) {
+        dotenv::unset("LAYER_PATH");
+        auto [error, count] = dotenv::load_layers(
+            paths, {.apply_to_process = dotenv::process_env_apply::no,
+                    .expansion = expansion});
+        EXPECT_EQ(error, dotenv::dotenv_error::success);
+        EXPECT_EQ(count, 3);
+        EXPECT_EQ(dotenv::value("LAYER_URL"), "pg://db:5432");
+        EXPECT_EQ(dotenv::value("LAYER_PATH"), "/usr/bin:/opt/bin");
+    }
+}
@@ -0,0 +1,125 @@
+#include "dotenv.h"
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+class LimitsTest : public TempDirTest {
+  protected:
+    LimitsTest()
+        : TempDirTest("limits", {"LIM_CERT", "LIM_A", "LIM_B", "LIM_C",
+                                 "LIM_LONGKEY", "LIM_LINE"}) {}
+
+    // Certificado de ~6 KB em linhas curtas, entre aspas
+    static auto certificate() -> std::string {
+        std::string pem = "-----BEGIN CERTIFICATE-----\n";
+        for (int i = 0; i < 96; ++i) {
+            pem += std::string(64, static_cast<char>('A' + (i % 26))) + "\n";
+        }
+        return pem + "-----END CERTIFICATE-----";
+    }
+};
+
+TEST_F(LimitsTest, RaisedValueLimitKeepsLargeCertificates) {
+    const auto pem = certificate();
+    const auto path = env_file("cert.env", "LIM_CERT=\"" + pem + "\"\n");
+
+    ASSERT_EQ(dotenv::load_legacy(path, internal()).first,
+              dotenv::dotenv_error::success);
+    EXPECT_EQ(dotenv::value("LIM_CERT").size(), 4096U);
+
+    for (auto backend : {dotenv::parse_backend::auto_detect,
+                         dotenv::parse_backend::traditional}) {
+        dotenv::load_options options = internal();
+        options.backend = backend;
+        options.limits.max_value_length = 16384;
+        ASSERT_EQ(dotenv::load_legacy(path, options).first,
+                  dotenv::dotenv_error::success);
+        EXPECT_EQ(dotenv::value("LIM_CERT"), pem);
+    }
+}
+
+TEST_F(LimitsTest, TighterLimitsRejectLinesAndKeys) {
+    const auto path = env_file("tight.env", "LIM_A=short\n"
+                                            "LIM_LONGKEY=1\n"
+                                            "LIM_LINE=" +
+                                                std::string(40, 'x') +
+                                                "\n"
+                                                "LIM_B=0123456789\n");
+    std::vector<dotenv::diagnostic_code> codes;
+    dotenv::load_options options = internal();
+    options.limits = {.max_line_length = 32,
+                      .max_key_length = 8,
+                      .max_value_length = 4};
+    options.on_diagnostic = [&codes](const dotenv::diagnostic &issue) {
+        codes.push_back(issue.code);
+    };
+
+    ASSERT_EQ(dotenv::load_legacy(path, options).first,
+              dotenv::dotenv_error::success);
+    EXPECT_EQ(dotenv::value("LIM_A"), "shor");
+    EXPECT_EQ(dotenv::value("LIM_B"), "0123");
+    EXPECT_FALSE(dotenv::contains("LIM_LONGKEY"));
+    EXPECT_FALSE(dotenv::contains("LIM_LINE"));
+    EXPECT_EQ(codes, (std::vector{dotenv::diagnostic_code::value_truncated,
+                                  dotenv::diagnostic_code::invalid_key,
+                                  dotenv::diagnostic_code::line_too_long,
+                                  dotenv::diagnostic_code::value_truncated}));
+}
+
+TEST_F(LimitsTest, FileSizeAndEntryCountBoundTheLoad) {
+    const auto path = env_file("many.env", "LIM_A=1\nLIM_B=2\nLIM_C=3\n");
+
+    dotenv::load_options options = internal();
+    options.limits.max_file_size = 10;
+    EXPECT_EQ(dotenv::load_legacy(path, options).first,
+              dotenv::dotenv_error::limit_exceeded);
+    EXPECT_EQ(dotenv::load_layers({path}, options).first,
+              dotenv::dotenv_error::limit_exceeded);
+    EXPECT_EQ(dotenv::reload(path, options).first,
+              dotenv::dotenv_error::limit_exceeded);
+    EXPECT_FALSE(dotenv::contains("LIM_A"));
+
+    size_t reported = 0;
+    options.limits = {.max_entries = 2};
+    options.on_diagnostic = [&reported](const dotenv::diagnostic &issue) {
+        EXPECT_EQ(issue.code, dotenv::diagnostic_code::too_many_entries);
+        EXPECT_EQ(issue.line, 3U);
+        ++reported;
+    };
+    auto [error, count] = dotenv::load_legacy(path, options);
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(reported, 1U);
+    EXPECT_TRUE(dotenv::contains("LIM_B"));
+    EXPECT_FALSE(dotenv::contains("LIM_C"));
+}
+
+TEST_F(LimitsTest, CApiHonorsLengthFields) {
+    const auto pem = certificate();
+    const auto path = env_file("cert.env", "LIM_CERT=\"" + pem + "\"\n");
+    dotenv_load_options_t options;
+    dotenv_get_default_options(&options);
+    options.apply_to_system = 0;
+    options.max_value_length = 16384;
+
+    ASSERT_EQ(dotenv_load_ex(path.c_str(), &options, nullptr),
+              DOTENV_SUCCESS);
+    EXPECT_EQ(dotenv::value("LIM_CERT"), pem);
+
+    const auto keys = env_file("keys.env", "LIM_A=1\nLIM_LONGKEY=2\n");
+    options.max_value_length = 0;
+    options.max_key_length = 8;
+    dotenv_load_stats_t stats{};
+    ASSERT_EQ(dotenv_load_ex(keys.c_str(), &options, &stats), DOTENV_SUCCESS);
+    EXPECT_EQ(stats.variables_loaded, 1);
+    EXPECT_EQ(stats.variables_rejected, 1);
+    EXPECT_FALSE(dotenv::contains("LIM_LONGKEY"));
+
+    EXPECT_STREQ(dotenv_get_error_message(DOTENV_ERROR_LIMIT_EXCEEDED),
+                 "Limit exceeded");
+}
@@ -0,0 +1,94 @@
+#include "dotenv.h"
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+class LoadReportTest : public TempDirTest {
+  protected:
+    LoadReportTest()
+        : TempDirTest("report", {"REPORT_A", "REPORT_PEM", "REPORT_BIG"}) {}
+
+    // Uma linha de cada tipo que o parser conta
+    auto mixed_file() const -> std::string {
+        return env_file("mixed.env",
+                        "# comment\n"
+                        "\n"
+                        "REPORT_A=1\n"
+                        "not a definition\n"
+                        "1BAD=x\n"
+                        "REPORT_PEM=\"first\nsecond\"\n"
+                        "REPORT_LONG=" +
+                            std::string(9000, 'x') + "\n" +
+                            "REPORT_BIG=" + std::string(5000, 'y') + "\n");
+    }
+};
+
+TEST_F(LoadReportTest, CountsEveryKindOfLine) {
+    auto [error, report] = dotenv::load_with_report(
+        mixed_file(), {.apply_to_process = dotenv::process_env_apply::no});
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+
+    EXPECT_EQ(report.variables_loaded, 3);
+    EXPECT_EQ(report.lines_processed, 9);
+    EXPECT_EQ(report.lines_skipped, 2);
+    EXPECT_EQ(report.lines_rejected, 2);
+    EXPECT_EQ(report.lines_too_long, 1);
+    EXPECT_EQ(report.values_truncated, 1);
+    EXPECT_EQ(dotenv::value("REPORT_PEM"), "first\nsecond");
+
+    // As fases são consecutivas e somam o total
+    EXPECT_GT(report.total.count(), 0);
+    EXPECT_EQ(report.total,
+              report.open + report.parse + report.commit + report.apply);
+}
+
+TEST_F(LoadReportTest, MissingFileReportsOnlyOpen) {
+    const auto missing = (test_dir_ / "missing.env").string();
+    auto [error, report] = dotenv::load_with_report(missing);
+    EXPECT_EQ(error, dotenv::dotenv_error::file_not_found);
+    EXPECT_EQ(report.variables_loaded, 0);
+    EXPECT_EQ(report.total, report.open);
+}
+
+TEST_F(LoadReportTest, CApiFillsStatsAndHonorsStructSize) {
+    const auto path = mixed_file();
+    dotenv_load_options_t options;
+    dotenv_get_default_options(&options);
+    options.apply_to_system = 0;
+
+    dotenv_load_stats_t stats{};
+    ASSERT_EQ(dotenv_load_ex(path.c_str(), &options, &stats), DOTENV_SUCCESS);
+    EXPECT_EQ(stats.variables_loaded, 3);
+    EXPECT_EQ(stats.variables_skipped, 2);
+    EXPECT_EQ(stats.variables_rejected, 3);
+    EXPECT_EQ(stats.lines_processed, 9);
+
+    dotenv_load_report_t report{};
+    report.struct_size = sizeof(report);
+    ASSERT_EQ(dotenv_load_report(path.c_str(), &options, &report),
+              DOTENV_SUCCESS);
+    EXPECT_EQ(report.version, DOTENV_LOAD_REPORT_VERSION);
+    EXPECT_EQ(report.stats.lines_processed, 9);
+    EXPECT_EQ(report.values_truncated, 1);
+    EXPECT_GT(report.total_ns, 0U);
+
+    // Um chamador compilado com uma versão menor da estrutura
+    dotenv_load_report_t older{};
+    older.struct_size = offsetof(dotenv_load_report_t, lines_too_long);
+    older.total_ns = 42;
+    ASSERT_EQ(dotenv_load_report(path.c_str(), &options, &older),
+              DOTENV_SUCCESS);
+    EXPECT_EQ(older.struct_size,
+              offsetof(dotenv_load_report_t, lines_too_long));
+    EXPECT_EQ(older.stats.variables_loaded, 3);
+    EXPECT_EQ(older.lines_too_long, 0);
+    EXPECT_EQ(older.total_ns, 42U);
+
+    EXPECT_EQ(dotenv_load_report(path.c_str(), &options, nullptr),
+              DOTENV_ERROR_INVALID_ARGUMENT);
+}
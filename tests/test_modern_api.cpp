@@ -1,3 +1,4 @@
+#include "dotenv.h"
 #include "dotenv.hpp"
 #include <filesystem>
 #include <fstream>
@@ -232,6 +233,58 @@ TEST_F(ModernDotenvAPITest, ForceSIMDBackend) {
 }
 #endif
 
+// ==== Test Change Detection ====
+
+TEST_F(ModernDotenvAPITest, SkipIfUnchangedReusesPreviousCount) {
+    dotenv::load_options opts{.apply_to_process = dotenv::process_env_apply::no,
+                              .skip_if_unchanged = true};
+
+    auto [error, count] = dotenv::load_legacy(test_env_file.string(), opts);
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+    ASSERT_GT(count, 0);
+
+    // Unchanged file: not reparsed, so the local override survives
+    dotenv::set("APP_NAME", "Overridden");
+    auto [skip_error, skip_count] =
+        dotenv::load_legacy(test_env_file.string(), opts);
+    EXPECT_EQ(skip_error, dotenv::dotenv_error::success);
+    EXPECT_EQ(skip_count, count);
+    EXPECT_EQ(dotenv::value("APP_NAME"), "Overridden");
+
+    // Rewritten with identical content: the content hash still matches
+    create_test_env_file();
+    EXPECT_EQ(dotenv::load_legacy(test_env_file.string(), opts).second, count);
+    EXPECT_EQ(dotenv::value("APP_NAME"), "Overridden");
+
+    // Different policies always reparse
+    auto replace_env = opts;
+    replace_env.apply_to_process = dotenv::process_env_apply::yes;
+    dotenv::load_legacy(test_env_file.string(), replace_env);
+    EXPECT_EQ(dotenv::value("APP_NAME"), "TestApp");
+
+    {
+        std::ofstream file(test_env_file, std::ios::app);
+        file << "EXTRA_KEY=1\n";
+    }
+    EXPECT_EQ(dotenv::load_legacy(test_env_file.string(), opts).second,
+              count + 1);
+    dotenv::unset("EXTRA_KEY");
+}
+
+TEST_F(ModernDotenvAPITest, LoadIfChangedReloadsAfterClear) {
+    int count = dotenv_load_if_changed(test_env_file.c_str(), 1, 0);
+    ASSERT_GT(count, 0);
+    EXPECT_EQ(dotenv_load_if_changed(test_env_file.c_str(), 1, 0), count);
+
+    // dotenv_clear empties the store, so the next call must reload
+    dotenv_clear(0);
+    EXPECT_EQ(dotenv_load_if_changed(test_env_file.c_str(), 1, 0), count);
+    EXPECT_EQ(dotenv::value("APP_NAME"), "TestApp");
+
+    EXPECT_EQ(dotenv_load_if_changed("nonexistent.env", 1, 0),
+              DOTENV_ERROR_FILE_NOT_FOUND);
+}
+
 // ==== Test File Operations ====
 
 TEST_F(ModernDotenvAPITest, SaveToFile) {
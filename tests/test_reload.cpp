@@ -0,0 +1,151 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+class ReloadTest : public TempDirTest {
+  protected:
+    ReloadTest()
+        : TempDirTest("reload", {"POOL_SIZE", "POOL_TIMEOUT", "DB_PASSWORD",
+                                 "DB_USER", "LOG_LEVEL"}) {}
+
+    void SetUp() override {
+        TempDirTest::SetUp();
+        env_file_ = test_dir_ / "app.env";
+    }
+
+    void write_env(const std::string &content) const {
+        write_file(env_file_, content);
+    }
+
+    auto reload() const -> dotenv::change_set {
+        auto [error, changes] =
+            dotenv::reload(env_file_.string(), internal());
+        EXPECT_EQ(error, dotenv::dotenv_error::success);
+        return changes;
+    }
+
+    std::filesystem::path env_file_;
+};
+
+using keys = std::vector<std::string>;
+
+TEST_F(ReloadTest, ReportsAddedRemovedAndChangedKeys) {
+    write_env("POOL_SIZE=10\nDB_USER=app\nLOG_LEVEL=info\n");
+    auto first = reload();
+    EXPECT_EQ(first.added, (keys{"DB_USER", "LOG_LEVEL", "POOL_SIZE"}));
+    EXPECT_TRUE(first.removed.empty());
+    EXPECT_TRUE(first.changed.empty());
+
+    write_env("POOL_SIZE=20\nDB_USER=app\nPOOL_TIMEOUT=5\n");
+    auto second = reload();
+    EXPECT_EQ(second.added, (keys{"POOL_TIMEOUT"}));
+    EXPECT_EQ(second.removed, (keys{"LOG_LEVEL"}));
+    EXPECT_EQ(second.changed, (keys{"POOL_SIZE"}));
+    EXPECT_EQ(dotenv::value("POOL_SIZE"), "20");
+    EXPECT_FALSE(dotenv::snapshot{}.contains("LOG_LEVEL"));
+
+    // Same content: nothing to report
+    EXPECT_TRUE(reload().empty());
+}
+
+TEST_F(ReloadTest, SubscribersReceiveOnlyMatchingKeys) {
+    write_env("POOL_SIZE=10\nDB_PASSWORD=old\n");
+    reload();
+
+    std::vector<dotenv::change_set> pool_changes;
+    std::vector<dotenv::change_set> db_changes;
+    auto pool_sub = dotenv::subscribe("POOL_", [&](const auto &changes) {
+        pool_changes.push_back(changes);
+    });
+    auto db_sub = dotenv::subscribe("DB_", [&](const auto &changes) {
+        // Callbacks run outside the store locks
+        EXPECT_EQ(dotenv::value("DB_PASSWORD"), "rotated");
+        db_changes.push_back(changes);
+    });
+
+    write_env("POOL_SIZE=10\nDB_PASSWORD=rotated\n");
+    reload();
+
+    EXPECT_TRUE(pool_changes.empty());
+    ASSERT_EQ(db_changes.size(), 1U);
+    EXPECT_EQ(db_changes[0].changed, (keys{"DB_PASSWORD"}));
+
+    db_sub.reset();
+    EXPECT_FALSE(db_sub.active());
+    write_env("POOL_SIZE=32\nDB_PASSWORD=again\n");
+    reload();
+
+    ASSERT_EQ(pool_changes.size(), 1U);
+    EXPECT_EQ(pool_changes[0].changed, (keys{"POOL_SIZE"}));
+    EXPECT_EQ(db_changes.size(), 1U);
+}
+
+TEST_F(ReloadTest, FirstReloadDiffsAgainstKeysFromLoad) {
+    write_env("POOL_SIZE=10\nLOG_LEVEL=info\n");
+    ASSERT_EQ(dotenv::load_legacy(env_file_.string(),
+                                  {.apply_to_process =
+                                       dotenv::process_env_apply::no})
+                  .first,
+              dotenv::dotenv_error::success);
+
+    write_env("POOL_SIZE=20\n");
+    auto changes = reload();
+    EXPECT_TRUE(changes.added.empty());
+    EXPECT_EQ(changes.removed, (keys{"LOG_LEVEL"}));
+    EXPECT_EQ(changes.changed, (keys{"POOL_SIZE"}));
+    EXPECT_FALSE(dotenv::snapshot{}.contains("LOG_LEVEL"));
+}
+
+TEST_F(ReloadTest, KeysChangedElsewhereAreLeftAlone) {
+    write_env("POOL_SIZE=10\nLOG_LEVEL=info\n");
+    reload();
+    dotenv::set("POOL_SIZE", "99");
+    dotenv::set("LOG_LEVEL", "debug");
+
+    // The file drops LOG_LEVEL and changes POOL_SIZE, but both were
+    // overwritten by set() after the previous reload
+    write_env("POOL_SIZE=20\n");
+    EXPECT_TRUE(reload().empty());
+    EXPECT_EQ(dotenv::value("POOL_SIZE"), "99");
+    EXPECT_EQ(dotenv::value("LOG_LEVEL"), "debug");
+}
+
+TEST_F(ReloadTest, PreserveKeepsExistingProcessVariables) {
+    ::setenv("DB_USER", "from-process", 1);
+    const dotenv::load_options options{
+        .overwrite_policy = dotenv::overwrite::preserve,
+        .apply_to_process = dotenv::process_env_apply::yes};
+
+    write_env("DB_USER=app\nLOG_LEVEL=info\n");
+    ASSERT_EQ(dotenv::reload(env_file_.string(), options).first,
+              dotenv::dotenv_error::success);
+    EXPECT_STREQ(std::getenv("DB_USER"), "from-process");
+    EXPECT_STREQ(std::getenv("LOG_LEVEL"), "info");
+
+    write_env("DB_USER=app2\nLOG_LEVEL=warn\n");
+    auto [error, changes] = dotenv::reload(env_file_.string(), options);
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(changes.changed, (keys{"DB_USER", "LOG_LEVEL"}));
+    EXPECT_STREQ(std::getenv("DB_USER"), "from-process");
+    EXPECT_STREQ(std::getenv("LOG_LEVEL"), "warn");
+
+    write_env("");
+    ASSERT_EQ(dotenv::reload(env_file_.string(), options).first,
+              dotenv::dotenv_error::success);
+    EXPECT_STREQ(std::getenv("DB_USER"), "from-process");
+    EXPECT_EQ(std::getenv("LOG_LEVEL"), nullptr);
+    ::unsetenv("DB_USER");
+}
+
+TEST_F(ReloadTest, MissingFileReportsError) {
+    auto [error, changes] =
+        dotenv::reload((test_dir_ / "missing.env").string(), {});
+    EXPECT_EQ(error, dotenv::dotenv_error::file_not_found);
+    EXPECT_TRUE(changes.empty());
+}
@@ -0,0 +1,220 @@
+#include "dotenv.h"
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+class SaveTest : public TempDirTest {
+  protected:
+    SaveTest()
+        : TempDirTest("save", {"SAVE_A", "SAVE_B", "SAVE_C", "SAVE_NEW"}) {
+        for (const auto &[key, value] : tricky_values()) {
+            track_key(key);
+        }
+    }
+
+    void SetUp() override {
+        TempDirTest::SetUp();
+        output_ = (test_dir_ / "saved.env").string();
+    }
+
+    static auto tricky_values()
+        -> std::vector<std::pair<std::string, std::string>> {
+        return {{"SAVE_PLAIN", "postgres://db:5432/app"},
+                {"SAVE_EMPTY", ""},
+                {"SAVE_HASH", "value # not a comment"},
+                {"SAVE_MULTILINE", "-----BEGIN-----\nabc\n-----END-----"},
+                {"SAVE_PADDED", "  padded\t"},
+                {"SAVE_DOLLAR", "${NOT_EXPANDED} costs $5"},
+                {"SAVE_QUOTES", "it's \"quoted\"\nand \\ escaped"},
+                {"SAVE_LEADING_QUOTE", "\"starts with a quote"},
+                {"SAVE_CR", "carriage\rreturn"}};
+    }
+
+    std::string output_;
+};
+
+TEST_F(SaveTest, ValuesRoundTrip) {
+    for (const auto &[key, value] : tricky_values()) {
+        dotenv::set(key, value);
+    }
+
+    dotenv::save_to_file(output_);
+    for (const auto &[key, value] : tricky_values()) {
+        dotenv::unset(key);
+    }
+
+    const dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no};
+    ASSERT_EQ(dotenv::load_legacy(output_, options).first,
+              dotenv::dotenv_error::success);
+    for (const auto &[key, value] : tricky_values()) {
+        EXPECT_EQ(dotenv::value(key, "<missing>"), value) << key;
+    }
+
+    // Plain values stay readable; '$' is single-quoted to stay literal
+    const auto content = read_file(output_);
+    EXPECT_NE(content.find("SAVE_PLAIN=postgres://db:5432/app\n"),
+              std::string::npos);
+    EXPECT_NE(content.find("SAVE_DOLLAR='${NOT_EXPANDED} costs $5'\n"),
+              std::string::npos);
+}
+
+TEST_F(SaveTest, ReplacesFileAtomically) {
+    {
+        std::ofstream existing(output_);
+        existing << "OLD_CONTENT=1\n";
+    }
+    ASSERT_EQ(::chmod(output_.c_str(), 0600), 0);
+    dotenv::set("SAVE_PLAIN", "new");
+
+    dotenv::save_to_file(output_);
+
+    const auto content = read_file(output_);
+    EXPECT_EQ(content.find("OLD_CONTENT"), std::string::npos);
+    EXPECT_NE(content.find("SAVE_PLAIN=new\n"), std::string::npos);
+
+    // The existing file's permissions survive and no temporary is left
+    struct stat info {};
+    ASSERT_EQ(::stat(output_.c_str(), &info), 0);
+    EXPECT_EQ(info.st_mode & 0777, 0600U);
+    size_t files = 0;
+    for ([[maybe_unused]] const auto &entry :
+         std::filesystem::directory_iterator(test_dir_)) {
+        ++files;
+    }
+    EXPECT_EQ(files, 1U);
+}
+
+TEST_F(SaveTest, SymlinkedTargetIsUpdatedThroughTheLink) {
+    const auto real = test_dir_ / "real.env";
+    {
+        std::ofstream existing(real);
+        existing << "OLD_CONTENT=1\n";
+    }
+    std::filesystem::create_symlink(real, output_);
+    dotenv::set("SAVE_PLAIN", "through-link");
+
+    dotenv::save_to_file(output_);
+
+    EXPECT_TRUE(std::filesystem::is_symlink(output_));
+    const auto content = read_file(real.string());
+    EXPECT_EQ(content.find("OLD_CONTENT"), std::string::npos);
+    EXPECT_NE(content.find("SAVE_PLAIN=through-link\n"), std::string::npos);
+}
+
+TEST_F(SaveTest, QuoteAndDollarOnlyRoundTripWithoutInterpolation) {
+    const std::string value = "it's $SAVE_UNDEFINED_REF";
+    dotenv::set("SAVE_A", value);
+    dotenv::save_to_file(output_);
+    EXPECT_NE(read_file(output_).find("SAVE_A=\"it's $SAVE_UNDEFINED_REF\"\n"),
+              std::string::npos);
+
+    dotenv::unset("SAVE_A");
+    ASSERT_EQ(dotenv::load_legacy(output_, {.apply_to_process =
+                                                dotenv::process_env_apply::no})
+                  .first,
+              dotenv::dotenv_error::success);
+    EXPECT_EQ(dotenv::value("SAVE_A"), value);
+
+    // Documented limit: interpolating loads expand the unescaped '$'
+    dotenv::unset("SAVE_A");
+    ASSERT_EQ(
+        dotenv::load_legacy(output_,
+                            {.apply_to_process = dotenv::process_env_apply::no,
+                             .expansion = dotenv::interpolation::eager})
+            .first,
+        dotenv::dotenv_error::success);
+    EXPECT_EQ(dotenv::value("SAVE_A"), "it's ");
+}
+
+TEST_F(SaveTest, ReportsWriteFailure) {
+    const auto missing_dir = (test_dir_ / "missing" / "out.env").string();
+    EXPECT_THROW(dotenv::save_to_file(missing_dir), std::runtime_error);
+    EXPECT_EQ(dotenv_save(missing_dir.c_str()),
+              DOTENV_ERROR_PERMISSION_DENIED);
+    EXPECT_FALSE(std::filesystem::exists(missing_dir));
+}
+
+TEST_F(SaveTest, SortedOutputIsStable) {
+    dotenv::set("SAVE_C", "3");
+    dotenv::set("SAVE_A", "1");
+    dotenv::set("SAVE_B", "2");
+
+    dotenv::save_to_file(output_, {.sorted = true});
+    const auto first = read_file(output_);
+    dotenv::save_to_file(output_, {.sorted = true});
+
+    EXPECT_EQ(read_file(output_), first);
+    const auto pos_a = first.find("SAVE_A=1\n");
+    const auto pos_b = first.find("SAVE_B=2\n");
+    const auto pos_c = first.find("SAVE_C=3\n");
+    ASSERT_NE(pos_c, std::string::npos);
+    EXPECT_LT(pos_a, pos_b);
+    EXPECT_LT(pos_b, pos_c);
+}
+
+TEST_F(SaveTest, PreserveLayoutPatchesOnlyChangedLines) {
+    {
+        std::ofstream existing(output_);
+        existing << "# Database\n"
+                    "export SAVE_A=1   # first\n"
+                    "\n"
+                    "SAVE_B='two'\n"
+                    "SAVE_C=\"multi\nline\"\n"
+                    "SAVE_GONE=removed\n"
+                    "# trailing comment";
+    }
+    dotenv::set("SAVE_A", "1");
+    dotenv::set("SAVE_B", "changed");
+    dotenv::set("SAVE_C", "multi\nline");
+    dotenv::set("SAVE_NEW", "appended");
+
+    dotenv::save_to_file(output_, {.preserve_layout = true});
+    const auto content = read_file(output_);
+
+    EXPECT_EQ(content.rfind("# Database\n"
+                            "export SAVE_A=1   # first\n"
+                            "\n"
+                            "SAVE_B=changed\n"
+                            "SAVE_C=\"multi\nline\"\n"
+                            "# trailing comment\n",
+                            0),
+              0U);
+    EXPECT_EQ(content.find("SAVE_GONE"), std::string::npos);
+    EXPECT_NE(content.find("\nSAVE_NEW=appended\n"), std::string::npos);
+
+    // Nothing changed since: the file is not rewritten
+    struct stat before {};
+    ASSERT_EQ(::stat(output_.c_str(), &before), 0);
+    dotenv::save_to_file(output_, {.preserve_layout = true});
+    struct stat after {};
+    ASSERT_EQ(::stat(output_.c_str(), &after), 0);
+    EXPECT_EQ(before.st_ino, after.st_ino);
+    EXPECT_EQ(read_file(output_), content);
+}
+
+TEST_F(SaveTest, PreserveLayoutKeepsInterpolatedTemplates) {
+    {
+        std::ofstream existing(output_);
+        existing << "SAVE_A=db\nSAVE_B=${SAVE_A}:5432\n";
+    }
+    const dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no,
+        .expansion = dotenv::interpolation::eager};
+    ASSERT_EQ(dotenv::load_legacy(output_, options).first,
+              dotenv::dotenv_error::success);
+    ASSERT_EQ(dotenv::value("SAVE_B"), "db:5432");
+
+    dotenv::save_to_file(output_, {.preserve_layout = true});
+    EXPECT_EQ(read_file(output_).rfind("SAVE_A=db\nSAVE_B=${SAVE_A}:5432\n", 0),
+              0U);
+}
@@ -0,0 +1,133 @@
+#include "dotenv.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+class SharedStoreTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        name_ = "dotenv_shared_test_" + std::to_string(::getpid());
+    }
+
+    void TearDown() override {
+        (void)dotenv::unlink_shared(name_);
+        for (const char *key : {"SHM_HOST", "SHM_PORT", "SHM_URL"}) {
+            dotenv::unset(key);
+        }
+    }
+
+    std::string name_;
+};
+
+TEST_F(SharedStoreTest, ReadersSeeEachPublication) {
+    EXPECT_EQ(dotenv::attach_shared(name_).first,
+              dotenv::dotenv_error::file_not_found);
+
+    dotenv::set("SHM_HOST", "db.local");
+    dotenv::set("SHM_PORT", "5432");
+    ASSERT_EQ(dotenv::publish_shared(name_), dotenv::dotenv_error::success);
+
+    auto [error, shared] = dotenv::attach_shared("/" + name_);
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(shared.version(), 1U);
+    EXPECT_EQ(shared.get("SHM_HOST"), "db.local");
+    EXPECT_EQ(shared.get("SHM_PORT"), "5432");
+    EXPECT_FALSE(shared.contains("SHM_URL"));
+    EXPECT_GE(shared.size(), 2U);
+
+    // Republishing rewrites the segment in place
+    dotenv::set("SHM_HOST", "replica.local");
+    dotenv::unset("SHM_PORT");
+    ASSERT_EQ(dotenv::publish_shared(name_), dotenv::dotenv_error::success);
+    EXPECT_EQ(shared.version(), 2U);
+    EXPECT_EQ(shared.get("SHM_HOST"), "replica.local");
+    EXPECT_FALSE(shared.find("SHM_PORT").has_value());
+}
+
+TEST_F(SharedStoreTest, OtherProcessesAttachReadOnly) {
+    dotenv::set("SHM_URL", "postgres://db.local/app");
+    ASSERT_EQ(dotenv::publish_shared(name_), dotenv::dotenv_error::success);
+
+    const pid_t child = ::fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        auto [error, shared] = dotenv::attach_shared(name_);
+        const bool ok = error == dotenv::dotenv_error::success &&
+                        shared.get("SHM_URL") == "postgres://db.local/app";
+        ::_exit(ok ? 0 : 1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST_F(SharedStoreTest, CapacityIsFixedAtCreation) {
+    dotenv::set("SHM_HOST", "a");
+    ASSERT_EQ(dotenv::publish_shared(name_, 1), dotenv::dotenv_error::success);
+
+    dotenv::set("SHM_URL", std::string(64 * 1024, 'x'));
+    EXPECT_EQ(dotenv::publish_shared(name_),
+              dotenv::dotenv_error::buffer_too_small);
+
+    // The previous publication stays readable
+    auto [error, shared] = dotenv::attach_shared(name_);
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(shared.get("SHM_HOST"), "a");
+    EXPECT_FALSE(shared.contains("SHM_URL"));
+}
+
+TEST_F(SharedStoreTest, SegmentIsPrivateToTheOwner) {
+    dotenv::set("SHM_HOST", "db.local");
+    ASSERT_EQ(dotenv::publish_shared(name_), dotenv::dotenv_error::success);
+
+    const int fd = ::shm_open(("/" + name_).c_str(), O_RDONLY, 0);
+    ASSERT_NE(fd, -1);
+    struct stat info {};
+    ASSERT_EQ(::fstat(fd, &info), 0);
+    ::close(fd);
+    EXPECT_EQ(info.st_mode & 0777, 0600U);
+}
+
+TEST_F(SharedStoreTest, ReadsFailWhilePublisherDiedMidPublication) {
+    dotenv::set("SHM_HOST", "db.local");
+    ASSERT_EQ(dotenv::publish_shared(name_), dotenv::dotenv_error::success);
+    auto [error, shared] = dotenv::attach_shared(name_);
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+
+    // Leave the sequence odd, as a publisher killed between its two
+    // increments would (the sequence follows the 8-byte magic and 2 words)
+    const int fd = ::shm_open(("/" + name_).c_str(), O_RDWR, 0);
+    ASSERT_NE(fd, -1);
+    void *data = ::mmap(nullptr, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    ASSERT_NE(data, MAP_FAILED);
+    auto *sequence = static_cast<std::uint64_t *>(data) + 2;
+    *sequence += 1;
+
+    EXPECT_THROW((void)shared.find("SHM_HOST"), std::system_error);
+    EXPECT_THROW((void)shared.get("SHM_HOST"), std::system_error);
+    ::munmap(data, 64);
+
+    // The next publication repairs the sequence
+    ASSERT_EQ(dotenv::publish_shared(name_), dotenv::dotenv_error::success);
+    EXPECT_EQ(shared.get("SHM_HOST"), "db.local");
+}
+
+TEST_F(SharedStoreTest, RejectsInvalidNames) {
+    EXPECT_EQ(dotenv::publish_shared("a/b"),
+              dotenv::dotenv_error::invalid_argument);
+    EXPECT_EQ(dotenv::attach_shared("/").first,
+              dotenv::dotenv_error::invalid_argument);
+}
+
+#endif
@@ -0,0 +1,271 @@
+#include "dotenv.h"
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+class SnapshotTest : public TempDirTest {
+  protected:
+    SnapshotTest()
+        : TempDirTest("snapshot",
+                      {"SNAP_KEY", "SNAP_OTHER", "SNAP_HOT", "SNAP_HOST",
+                       "SNAP_PORT", "SNAP_PAIR_A", "SNAP_PAIR_B",
+                       "SNAPX_KAFKA_BROKERS", "SNAPX_KAFKA_GROUP",
+                       "SNAPX_KAFKAESQUE", "SNAPX_REDIS_URL"}) {}
+};
+
+TEST_F(SnapshotTest, ViewSurvivesOverwriteAndUnset) {
+    dotenv::set("SNAP_KEY", "first_value_long_enough_to_avoid_sso");
+
+    dotenv::snapshot pinned;
+    auto view = pinned.get("SNAP_KEY");
+    EXPECT_EQ(view, "first_value_long_enough_to_avoid_sso");
+
+    dotenv::set("SNAP_KEY", "second_value");
+    dotenv::unset("SNAP_KEY");
+
+    // The pinned view still refers to the original storage
+    EXPECT_EQ(view, "first_value_long_enough_to_avoid_sso");
+    EXPECT_EQ(pinned.get("SNAP_KEY"), "first_value_long_enough_to_avoid_sso");
+    EXPECT_FALSE(dotenv::snapshot{}.contains("SNAP_KEY"));
+}
+
+TEST_F(SnapshotTest, SeesPointInTimeState) {
+    dotenv::set("SNAP_KEY", "before");
+    dotenv::snapshot pinned;
+
+    dotenv::set("SNAP_OTHER", "added_later");
+
+    EXPECT_TRUE(pinned.contains("SNAP_KEY"));
+    EXPECT_FALSE(pinned.find("SNAP_OTHER").has_value());
+    EXPECT_EQ(pinned.get("SNAP_OTHER", "fallback"), "fallback");
+
+    dotenv::snapshot latest;
+    EXPECT_EQ(latest.get("SNAP_OTHER"), "added_later");
+    EXPECT_GT(latest.generation(), pinned.generation());
+    EXPECT_EQ(latest.size(), pinned.size() + 1);
+}
+
+TEST_F(SnapshotTest, ConcurrentWritesDoNotInvalidateViews) {
+    dotenv::set("SNAP_HOT", std::string(64, 'a'));
+    std::atomic<bool> stop{false};
+
+    std::thread writer([&stop]() {
+        for (int i = 0; !stop.load(); ++i) {
+            dotenv::set("SNAP_HOT", std::string(64, (i % 2 == 0) ? 'b' : 'a'));
+        }
+    });
+
+    for (int i = 0; i < 2000; ++i) {
+        dotenv::snapshot pinned;
+        auto view = pinned.get("SNAP_HOT");
+        ASSERT_EQ(view.size(), 64U);
+        // All characters come from the same write
+        EXPECT_EQ(view.find_first_not_of(view.front()), std::string_view::npos);
+    }
+
+    stop = true;
+    writer.join();
+}
+
+TEST_F(SnapshotTest, CInterface) {
+    dotenv_set("SNAP_KEY", "c_value", 1);
+
+    dotenv_snapshot_t *pinned = dotenv_snapshot_acquire();
+    ASSERT_NE(pinned, nullptr);
+
+    const char *value = dotenv_snapshot_get(pinned, "SNAP_KEY", nullptr);
+    dotenv_unset("SNAP_KEY");
+
+    EXPECT_STREQ(value, "c_value");
+    EXPECT_STREQ(dotenv_snapshot_get(pinned, "SNAP_MISSING", "def"), "def");
+    EXPECT_STREQ(dotenv_snapshot_get(pinned, "SNAP_MISSING", nullptr), "");
+
+    dotenv_snapshot_release(pinned);
+    dotenv_snapshot_release(nullptr);
+}
+
+TEST_F(SnapshotTest, ReadConsistentRetriesWhenWriterPublishes) {
+    dotenv::set("SNAP_HOST", "db1");
+    dotenv::set("SNAP_PORT", "5432");
+
+    int attempts = 0;
+    std::string host;
+    std::string port;
+    const auto generation =
+        dotenv::read_consistent([&](const dotenv::view &env) {
+            ++attempts;
+            host = env.get("SNAP_HOST");
+            if (attempts == 1) {
+                // A writer publishes in the middle of the first attempt
+                dotenv::set("SNAP_HOST", "db2");
+                dotenv::set("SNAP_PORT", "6432");
+            }
+            port = env.get("SNAP_PORT");
+            EXPECT_TRUE(env.contains("SNAP_PORT"));
+            EXPECT_FALSE(env.find("SNAP_MISSING").has_value());
+        });
+
+    EXPECT_EQ(attempts, 2);
+    EXPECT_EQ(host, "db2");
+    EXPECT_EQ(port, "6432");
+    EXPECT_EQ(generation, dotenv::snapshot{}.generation());
+}
+
+TEST_F(SnapshotTest, ReadConsistentIgnoresWritesToOtherShards) {
+    dotenv::set("SNAP_HOST", "db1");
+
+    // Some of these keys live in other shards than SNAP_HOST; writing one of
+    // them while the reader runs must not force another attempt
+    int single_attempt_reads = 0;
+    for (int i = 0; i < 16; ++i) {
+        const auto other = "SNAP_SHARD_" + std::to_string(i);
+        int attempts = 0;
+        std::string host;
+        dotenv::read_consistent([&](const dotenv::view &env) {
+            ++attempts;
+            host = env.get("SNAP_HOST");
+            if (attempts == 1) {
+                dotenv::set(other, "written");
+            }
+        });
+        EXPECT_EQ(host, "db1");
+        if (attempts == 1) {
+            ++single_attempt_reads;
+        }
+        dotenv::unset(other);
+    }
+
+    EXPECT_GT(single_attempt_reads, 0);
+}
+
+TEST_F(SnapshotTest, ReadConsistentSeesWholeBatches) {
+    const auto first = env_file("first.env", "SNAP_PAIR_A=1\nSNAP_PAIR_B=1\n");
+    const auto second =
+        env_file("second.env", "SNAP_PAIR_A=2\nSNAP_PAIR_B=2\n");
+    const dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no};
+    // load_layers() commits each file in one batch
+    ASSERT_EQ(dotenv::load_layers({first}, options).first,
+              dotenv::dotenv_error::success);
+    std::atomic<bool> stop{false};
+
+    std::thread writer([&]() {
+        for (int i = 0; !stop.load(); ++i) {
+            (void)dotenv::load_layers({(i % 2 == 0) ? second : first}, options);
+        }
+    });
+
+    for (int i = 0; i < 2000; ++i) {
+        std::string pair_a;
+        std::string pair_b;
+        dotenv::read_consistent([&](const dotenv::view &env) {
+            pair_a = env.get("SNAP_PAIR_A");
+            pair_b = env.get("SNAP_PAIR_B");
+        });
+        EXPECT_EQ(pair_a, pair_b);
+    }
+
+    stop = true;
+    writer.join();
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+}
+
+TEST_F(SnapshotTest, ReadConsistentExpandsDeferredValues) {
+    const auto path = env_file("lazy.env", "SNAP_HOST=db\n"
+                                           "SNAP_PORT=${SNAP_HOST}:5432\n");
+    const dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no,
+        .expansion = dotenv::interpolation::lazy};
+    ASSERT_EQ(dotenv::load_legacy(path, options).first,
+              dotenv::dotenv_error::success);
+
+    std::string port;
+    dotenv::read_consistent(
+        [&](const dotenv::view &env) { port = env.get("SNAP_PORT"); });
+
+    EXPECT_EQ(port, "db:5432");
+    std::filesystem::remove(path);
+}
+
+TEST_F(SnapshotTest, EntriesRangeIsPinned) {
+    dotenv::set("SNAP_KEY", "kept");
+    dotenv::set("SNAP_OTHER", "removed_later");
+
+    const auto range = dotenv::entries();
+    dotenv::unset("SNAP_OTHER");
+    dotenv::set("SNAP_HOT", "added_later");
+
+    std::map<std::string, std::string> seen;
+    for (auto [key, value] : range) {
+        seen.emplace(key, value);
+    }
+    EXPECT_EQ(seen.size(), range.size());
+    EXPECT_EQ(seen["SNAP_KEY"], "kept");
+    EXPECT_EQ(seen["SNAP_OTHER"], "removed_later");
+    EXPECT_FALSE(seen.contains("SNAP_HOT"));
+    EXPECT_LT(range.generation(), dotenv::snapshot{}.generation());
+}
+
+TEST_F(SnapshotTest, EnumerateCallbackMayWrite) {
+    dotenv::set("SNAP_KEY", "value");
+
+    // The callback writes to the store; with a lock held this would deadlock
+    auto writer = [](const char *key, const char *, void *) -> int {
+        if (std::string_view(key) == "SNAP_KEY") {
+            dotenv_set("SNAP_OTHER", "written_while_enumerating", 1);
+        }
+        return 0;
+    };
+    EXPECT_GE(dotenv_enumerate(writer, nullptr), 1);
+    EXPECT_EQ(dotenv::get("SNAP_OTHER"), "written_while_enumerating");
+}
+
+TEST_F(SnapshotTest, EntriesWithPrefix) {
+    dotenv::set("SNAPX_KAFKA_GROUP", "billing");
+    dotenv::set("SNAPX_REDIS_URL", "redis://cache");
+    dotenv::set("SNAPX_KAFKA_BROKERS", "k1:9092");
+
+    auto kafka = dotenv::entries_with_prefix("SNAPX_KAFKA_");
+    ASSERT_EQ(kafka.size(), 2U);
+    EXPECT_EQ(kafka.begin()->key, "SNAPX_KAFKA_BROKERS");
+    EXPECT_EQ(kafka.begin()->value, "k1:9092");
+    EXPECT_EQ(std::next(kafka.begin())->key, "SNAPX_KAFKA_GROUP");
+
+    // The index of a changed shard is rebuilt; the old range is unaffected
+    dotenv::set("SNAPX_KAFKAESQUE", "not_a_kafka_setting");
+    dotenv::unset("SNAPX_KAFKA_GROUP");
+    EXPECT_EQ(dotenv::entries_with_prefix("SNAPX_KAFKA").size(), 2U);
+    EXPECT_EQ(dotenv::entries_with_prefix("SNAPX_KAFKA_").size(), 1U);
+    EXPECT_EQ(kafka.size(), 2U);
+    EXPECT_EQ(std::next(kafka.begin())->value, "billing");
+    EXPECT_TRUE(dotenv::entries_with_prefix("SNAPX_MISSING_").empty());
+}
+
+TEST_F(SnapshotTest, EnumeratePrefixCInterface) {
+    dotenv_set("SNAPX_KAFKA_GROUP", "billing", 1);
+    dotenv_set("SNAPX_KAFKA_BROKERS", "k1:9092", 1);
+    dotenv_set("SNAPX_REDIS_URL", "redis://cache", 1);
+
+    std::vector<std::string> keys;
+    auto collect = [](const char *key, const char *, void *user_data) -> int {
+        static_cast<std::vector<std::string> *>(user_data)->emplace_back(key);
+        return 0;
+    };
+    EXPECT_EQ(dotenv_enumerate_prefix("SNAPX_KAFKA_", collect, &keys), 2);
+    EXPECT_EQ(keys, (std::vector<std::string>{"SNAPX_KAFKA_BROKERS",
+                                              "SNAPX_KAFKA_GROUP"}));
+
+    auto stop = [](const char *, const char *, void *) -> int { return 1; };
+    EXPECT_EQ(dotenv_enumerate_prefix("SNAPX_", stop, nullptr), 0);
+    EXPECT_EQ(dotenv_enumerate_prefix(nullptr, collect, &keys),
+              DOTENV_ERROR_INVALID_ARGUMENT);
+}
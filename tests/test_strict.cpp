@@ -0,0 +1,147 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+class StrictTest : public TempDirTest {
+  protected:
+    StrictTest()
+        : TempDirTest("strict", {"STRICT_A", "STRICT_B", "STRICT_BIG",
+                                 "STRICT_LAYER", "STRICT_LOCAL"}) {}
+};
+
+TEST_F(StrictTest, InvalidLineFailsTheWholeLoad) {
+    const auto path = env_file(
+        "bad.env", "# comment\n\nSTRICT_A=1\nnot a line\nSTRICT_B=2\n");
+
+    for (auto expansion :
+         {dotenv::interpolation::none, dotenv::interpolation::eager}) {
+        for (auto backend : {dotenv::parse_backend::auto_detect,
+                             dotenv::parse_backend::traditional,
+                             dotenv::parse_backend::simd}) {
+            std::vector<size_t> lines;
+            dotenv::load_options options{
+                .apply_to_process = dotenv::process_env_apply::yes,
+                .backend = backend,
+                .expansion = expansion,
+                .on_diagnostic =
+                    [&lines](const dotenv::diagnostic &issue) {
+                        lines.push_back(issue.line);
+                    },
+                .strict = true};
+            EXPECT_EQ(dotenv::load_legacy(path, options).first,
+                      dotenv::dotenv_error::invalid_format);
+            // O sink recebe a linha mesmo com a carga abortada
+            EXPECT_EQ(lines, std::vector<size_t>{4});
+            EXPECT_FALSE(dotenv::contains("STRICT_A"));
+            EXPECT_EQ(std::getenv("STRICT_A"), nullptr);
+        }
+    }
+
+    // Sem strict a linha é só ignorada
+    auto [error, count] = dotenv::load_legacy(
+        path, {.apply_to_process = dotenv::process_env_apply::no});
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(count, 2);
+}
+
+TEST_F(StrictTest, AlteredValuesCountAsInvalid) {
+    const auto path = env_file(
+        "big.env", "STRICT_A=1\nSTRICT_BIG=" + std::string(5000, 'x') + "\n");
+
+    EXPECT_EQ(dotenv::load_legacy(path, strict()).first,
+              dotenv::dotenv_error::invalid_format);
+    EXPECT_FALSE(dotenv::contains("STRICT_A"));
+
+    auto options = strict();
+    options.limits.max_value_length = 8192;
+    ASSERT_EQ(dotenv::load_legacy(path, options).first,
+              dotenv::dotenv_error::success);
+    EXPECT_EQ(dotenv::value("STRICT_BIG").size(), 5000U);
+}
+
+TEST_F(StrictTest, LayersAndReloadKeepTheCurrentState) {
+    const auto base = env_file("base.env", "STRICT_LAYER=base\n");
+    const auto local =
+        env_file("local.env", "STRICT_LAYER=local\n1BAD=x\nSTRICT_LOCAL=1\n");
+
+    for (bool parallel : {false, true}) {
+        auto options = strict();
+        options.parallel_parse = parallel;
+        EXPECT_EQ(dotenv::load_layers({base, local}, options).first,
+                  dotenv::dotenv_error::invalid_format);
+        EXPECT_FALSE(dotenv::contains("STRICT_LAYER"));
+    }
+
+    ASSERT_EQ(dotenv::reload(base, strict()).first,
+              dotenv::dotenv_error::success);
+    env_file("base.env", "STRICT_LAYER=changed\nbroken\n");
+    EXPECT_EQ(dotenv::reload(base, strict()).first,
+              dotenv::dotenv_error::invalid_format);
+    EXPECT_EQ(dotenv::value("STRICT_LAYER"), "base");
+}
+
+TEST_F(StrictTest, SkipIfUnchangedRevalidatesUnderStricterOptions) {
+    const auto path = env_file("skip.env", "STRICT_A=1\nnot a line\n");
+    dotenv::load_options lenient{
+        .apply_to_process = dotenv::process_env_apply::no,
+        .skip_if_unchanged = true};
+    ASSERT_EQ(dotenv::load_legacy(path, lenient).first,
+              dotenv::dotenv_error::success);
+
+    // Mesmo arquivo, sem mudanças: strict e limites menores reanalisam
+    auto checked = strict();
+    checked.skip_if_unchanged = true;
+    EXPECT_EQ(dotenv::load_legacy(path, checked).first,
+              dotenv::dotenv_error::invalid_format);
+
+    auto limited = lenient;
+    limited.limits.max_file_size = 4;
+    EXPECT_EQ(dotenv::load_legacy(path, limited).first,
+              dotenv::dotenv_error::limit_exceeded);
+
+    auto budgeted = lenient;
+    budgeted.budget.max_lines = 1;
+    EXPECT_EQ(dotenv::load_legacy(path, budgeted).first,
+              dotenv::dotenv_error::limit_exceeded);
+
+    // As opções originais continuam reaproveitando a carga anterior
+    EXPECT_EQ(dotenv::load_legacy(path, lenient),
+              std::pair(dotenv::dotenv_error::success, 1));
+}
+
+TEST_F(StrictTest, LoadsApplyOnlyTheirOwnKeysToTheProcess) {
+    const auto internal = env_file("internal.env", "STRICT_A=internal\n");
+    const auto applied = env_file("applied.env", "STRICT_B=applied\n");
+
+    for (auto expansion :
+         {dotenv::interpolation::none, dotenv::interpolation::eager}) {
+        dotenv::environment tenant;
+        for (auto *env : {&dotenv::default_environment(), &tenant}) {
+            ASSERT_EQ(
+                env->load(internal,
+                          {.apply_to_process = dotenv::process_env_apply::no,
+                           .expansion = expansion})
+                    .first,
+                dotenv::dotenv_error::success);
+            ASSERT_EQ(
+                env->load(applied,
+                          {.apply_to_process = dotenv::process_env_apply::yes,
+                           .expansion = expansion})
+                    .first,
+                dotenv::dotenv_error::success);
+
+            // Só a segunda carga chega ao processo
+            EXPECT_STREQ(std::getenv("STRICT_B"), "applied");
+            EXPECT_EQ(std::getenv("STRICT_A"), nullptr);
+            ::unsetenv("STRICT_B");
+            env->unset("STRICT_A");
+            env->unset("STRICT_B");
+        }
+    }
+}
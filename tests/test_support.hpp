@@ -0,0 +1,86 @@
+#pragma once
+
+#include "dotenv.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * Base das suítes que leem e gravam arquivos: um diretório temporário por
+ * suíte e por processo, criado no SetUp e removido no TearDown junto com as
+ * chaves que a suíte usa (do store padrão e do ambiente do processo).
+ *
+ * @code
+ * class LayersTest : public TempDirTest {
+ *   protected:
+ *     LayersTest() : TempDirTest("layers", {"LAYER_HOST", "LAYER_PORT"}) {}
+ * };
+ * @endcode
+ */
+class TempDirTest : public ::testing::Test {
+  protected:
+    TempDirTest(std::string_view suite,
+                std::initializer_list<std::string_view> keys)
+        : test_dir_(std::filesystem::temp_directory_path() /
+                    ("dotenv_" + std::string(suite) + "_test_" +
+                     std::to_string(static_cast<unsigned long>(::getpid())))),
+          keys_(keys.begin(), keys.end()) {}
+
+    void SetUp() override { std::filesystem::create_directories(test_dir_); }
+
+    void TearDown() override {
+        for (const auto &key : keys_) {
+            dotenv::unset(key);
+            ::unsetenv(key.c_str());
+        }
+        std::error_code error_code;
+        std::filesystem::remove_all(test_dir_, error_code);
+    }
+
+    // Chaves geradas durante o teste, removidas no TearDown
+    void track_key(std::string key) { keys_.push_back(std::move(key)); }
+
+    static void write_file(const std::filesystem::path &path,
+                           const std::string &content) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    // Grava `content` em `name` dentro do diretório da suíte
+    auto env_file(const std::string &name, const std::string &content) const
+        -> std::string {
+        auto path = test_dir_ / name;
+        write_file(path, content);
+        return path.string();
+    }
+
+    static auto read_file(const std::string &path) -> std::string {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Carga só no store interno
+    static auto internal() -> dotenv::load_options {
+        return {.apply_to_process = dotenv::process_env_apply::no};
+    }
+
+    static auto strict() -> dotenv::load_options {
+        return {.apply_to_process = dotenv::process_env_apply::no,
+                .strict = true};
+    }
+
+    std::filesystem::path test_dir_;
+
+  private:
+    std::vector<std::string> keys_;
+};
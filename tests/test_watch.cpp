@@ -0,0 +1,161 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+
+class WatchTest : public TempDirTest {
+  protected:
+    WatchTest() : TempDirTest("watch", {"WATCH_A", "WATCH_B", "WATCH_C"}) {}
+
+    void SetUp() override {
+        TempDirTest::SetUp();
+        file_ = test_dir_ / "app.env";
+    }
+
+    void TearDown() override {
+        handle_.stop();
+        TempDirTest::TearDown();
+    }
+
+    void start(std::chrono::milliseconds debounce = 50ms) {
+        handle_ = dotenv::watch(
+            file_.string(), internal(),
+            [this](const std::vector<std::string> &changed) {
+                std::lock_guard lock(mutex_);
+                ++reloads_;
+                last_changed_ = changed;
+                cv_.notify_all();
+            },
+            debounce);
+    }
+
+    // Espera até `count` recargas notificadas
+    auto wait_for_reloads(int count) -> bool {
+        std::unique_lock lock(mutex_);
+        return cv_.wait_for(lock, 5s, [&] { return reloads_ >= count; });
+    }
+
+    std::filesystem::path file_;
+    dotenv::watch_handle handle_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int reloads_{0};
+    std::vector<std::string> last_changed_;
+};
+
+TEST_F(WatchTest, LoadsOnStartAndReloadsInPlaceWrites) {
+    write_file(file_, "WATCH_A=1\nWATCH_B=2\n");
+    start();
+    EXPECT_TRUE(handle_.active());
+    EXPECT_EQ(dotenv::value("WATCH_A"), "1");
+
+    write_file(file_, "WATCH_A=1\nWATCH_B=3\nWATCH_C=4\n");
+    ASSERT_TRUE(wait_for_reloads(1));
+
+    std::lock_guard lock(mutex_);
+    EXPECT_EQ(last_changed_, (std::vector<std::string>{"WATCH_B", "WATCH_C"}));
+    EXPECT_EQ(dotenv::value("WATCH_B"), "3");
+    EXPECT_EQ(dotenv::value("WATCH_C"), "4");
+}
+
+TEST_F(WatchTest, DetectsAtomicRenameReplace) {
+    write_file(file_, "WATCH_A=old\nWATCH_B=gone\n");
+    start();
+
+    auto staged = test_dir_ / "app.env.tmp";
+    write_file(staged, "WATCH_A=new\n");
+    std::filesystem::rename(staged, file_);
+    ASSERT_TRUE(wait_for_reloads(1));
+
+    std::lock_guard lock(mutex_);
+    EXPECT_EQ(last_changed_, (std::vector<std::string>{"WATCH_A", "WATCH_B"}));
+    EXPECT_EQ(dotenv::value("WATCH_A"), "new");
+    EXPECT_FALSE(dotenv::snapshot{}.contains("WATCH_B"));
+}
+
+TEST_F(WatchTest, DebouncesBurstsOfWrites) {
+    write_file(file_, "WATCH_A=0\n");
+    start(100ms);
+
+    for (int i = 1; i <= 20; ++i) {
+        write_file(file_, "WATCH_A=" + std::to_string(i) + "\n");
+    }
+    ASSERT_TRUE(wait_for_reloads(1));
+    std::this_thread::sleep_for(300ms);
+
+    std::lock_guard lock(mutex_);
+    EXPECT_LT(reloads_, 5);
+    EXPECT_EQ(dotenv::value("WATCH_A"), "20");
+}
+
+TEST_F(WatchTest, SteadyEventsCannotPostponeTheReload) {
+    // ConfigMap-style symlink: every event in the directory is relevant
+    const auto data = test_dir_ / "data";
+    std::filesystem::create_directories(data);
+    write_file(data / "app.env", "WATCH_A=old\n");
+    std::filesystem::create_symlink(data / "app.env", file_);
+    start(100ms);
+
+    write_file(data / "app.env", "WATCH_A=new\n");
+    // A sibling rewritten well inside the debounce, for longer than the cap
+    const auto until = std::chrono::steady_clock::now() + 3s;
+    bool reloaded = false;
+    while (!reloaded && std::chrono::steady_clock::now() < until) {
+        write_file(test_dir_ / "noise.log", "tick\n");
+        std::unique_lock lock(mutex_);
+        reloaded = cv_.wait_for(lock, 20ms, [&] { return reloads_ >= 1; });
+    }
+
+    EXPECT_TRUE(reloaded);
+    EXPECT_EQ(dotenv::value("WATCH_A"), "new");
+}
+
+TEST_F(WatchTest, StopEndsWatching) {
+    write_file(file_, "WATCH_A=before\n");
+    start();
+    handle_.stop();
+    EXPECT_FALSE(handle_.active());
+
+    write_file(file_, "WATCH_A=after\n");
+    std::this_thread::sleep_for(200ms);
+
+    EXPECT_EQ(dotenv::value("WATCH_A"), "before");
+    std::lock_guard lock(mutex_);
+    EXPECT_EQ(reloads_, 0);
+}
+
+TEST_F(WatchTest, SharesOwnershipWithReload) {
+    write_file(file_, "WATCH_A=1\nWATCH_B=2\n");
+    start(10s);
+
+    // reload() sees what the watcher loaded and reports the dropped key
+    write_file(file_, "WATCH_A=1\n");
+    auto [error, changes] = dotenv::reload(
+        file_.string(), {.apply_to_process = dotenv::process_env_apply::no});
+    handle_.stop();
+    ASSERT_EQ(error, dotenv::dotenv_error::success);
+    EXPECT_EQ(changes.removed, (std::vector<std::string>{"WATCH_B"}));
+    EXPECT_FALSE(dotenv::snapshot{}.contains("WATCH_B"));
+}
+
+TEST_F(WatchTest, MissingDirectoryThrows) {
+    EXPECT_THROW((void)dotenv::watch(
+                     (test_dir_ / "missing" / "app.env").string(), {}, nullptr),
+                 std::system_error);
+}
+
+#endif
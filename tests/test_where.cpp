@@ -0,0 +1,66 @@
+#include "dotenv.hpp"
+#include "test_support.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+class WhereTest : public TempDirTest {
+  protected:
+    WhereTest()
+        : TempDirTest("where",
+                      {"WHERE_HOST", "WHERE_PORT", "WHERE_PEM", "WHERE_SET"}) {}
+};
+
+TEST_F(WhereTest, ReportsFileLineAndOffset) {
+    const auto path = env_file("app.env", "# comment\n"
+                                          "WHERE_PEM=\"line one\nline two\"\n"
+                                          "WHERE_HOST=db\n");
+    const dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no};
+    ASSERT_EQ(dotenv::load_legacy(path, options).first,
+              dotenv::dotenv_error::success);
+
+    const auto pem = dotenv::where("WHERE_PEM");
+    ASSERT_TRUE(pem.has_value());
+    EXPECT_EQ(pem->file, path);
+    EXPECT_EQ(pem->line, 2U);
+    EXPECT_EQ(pem->offset, 10U);
+
+    // The multi-line value above moves the next definition to line 4
+    const auto host = dotenv::where("WHERE_HOST");
+    ASSERT_TRUE(host.has_value());
+    EXPECT_EQ(host->line, 4U);
+    EXPECT_EQ(host->offset, 40U);
+}
+
+TEST_F(WhereTest, LayeredLoadNamesTheWinningLayer) {
+    const auto base = env_file(".env", "WHERE_HOST=base\nWHERE_PORT=1\n");
+    const auto local = env_file(".env.local", "\nWHERE_HOST=local\n");
+    const dotenv::load_options options{
+        .apply_to_process = dotenv::process_env_apply::no};
+    ASSERT_EQ(dotenv::load_layers({base, local}, options).first,
+              dotenv::dotenv_error::success);
+
+    EXPECT_EQ(dotenv::where("WHERE_HOST")->file, local);
+    EXPECT_EQ(dotenv::where("WHERE_HOST")->line, 2U);
+    EXPECT_EQ(dotenv::where("WHERE_PORT")->file, base);
+    EXPECT_EQ(dotenv::where("WHERE_PORT")->line, 2U);
+}
+
+TEST_F(WhereTest, ProgrammaticValuesHaveNoLocation) {
+    dotenv::set("WHERE_SET", "runtime");
+    EXPECT_FALSE(dotenv::where("WHERE_SET").has_value());
+    EXPECT_FALSE(dotenv::where("WHERE_MISSING").has_value());
+
+    // Overriding a loaded value drops its location
+    const auto path = env_file("app.env", "WHERE_HOST=db\n");
+    ASSERT_EQ(dotenv::load_legacy(path, {.apply_to_process =
+                                             dotenv::process_env_apply::no})
+                  .first,
+              dotenv::dotenv_error::success);
+    ASSERT_TRUE(dotenv::where("WHERE_HOST").has_value());
+    dotenv::set("WHERE_HOST", "override");
+    EXPECT_FALSE(dotenv::where("WHERE_HOST").has_value());
+}